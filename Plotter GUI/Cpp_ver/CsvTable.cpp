@@ -0,0 +1,440 @@
+#include "CsvTable.h"
+
+#include <QFile>
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// chunks smaller than this are not worth a thread
+static const qint64 MinChunkSize = 64 * 1024;
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+namespace
+{
+    struct Chunk
+    {
+        const char *begin;
+        const char *end;
+
+        int numColumns;
+        QVector<QVector<double>> columns;
+    };
+}
+
+static inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// strtod is locale dependent and needs a terminated string,
+// what we don't have in a memory mapped file
+
+static double parseNumber(const char *p, const char *end, bool *ok)
+{
+    static const double powersOf10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    while (p < end && isBlank(*p))
+        p++;
+
+    while (end > p && isBlank(end[-1]))
+        end--;
+
+    *ok = false;
+
+    if (p == end)
+        return NaN;
+
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    quint64 mantissa = 0;
+    int numDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+
+    for (; p < end && isDigit(*p); p++) {
+        hasDigits = true;
+
+        if (numDigits < 18) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa)
+                numDigits++;
+        } else {
+            exponent++;
+        }
+    }
+
+    if (p < end && *p == '.') {
+        for (p++; p < end && isDigit(*p); p++) {
+            hasDigits = true;
+
+            if (numDigits < 18) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa)
+                    numDigits++;
+                exponent--;
+            }
+        }
+    }
+
+    if (!hasDigits)
+        return NaN;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = (*p == '-');
+            p++;
+        }
+
+        if (p == end || !isDigit(*p))
+            return NaN;
+
+        int e = 0;
+        for (; p < end && isDigit(*p); p++) {
+            if (e < 10000)
+                e = e * 10 + (*p - '0');
+        }
+
+        exponent += negativeExponent ? -e : e;
+    }
+
+    if (p != end)
+        return NaN;
+
+    double value = static_cast<double>(mantissa);
+
+    if (exponent >= 0 && exponent <= 22)
+        value *= powersOf10[exponent];
+    else if (exponent < 0 && exponent >= -22)
+        value /= powersOf10[-exponent];
+    else
+        value *= std::pow(10.0, exponent);
+
+    *ok = true;
+    return negative ? -value : value;
+}
+
+static void parseLine(const char *p, const char *eol, Chunk &chunk)
+{
+    double values[64];
+    const int numColumns = chunk.numColumns;
+
+    bool isEmpty = true;
+
+    for (int col = 0; col < numColumns; col++) {
+        if (p > eol) {
+            values[col] = NaN; // missing fields
+            continue;
+        }
+
+        const char *sep = static_cast<const char *>(std::memchr(p, ',', eol - p));
+        if (sep == nullptr)
+            sep = eol;
+
+        bool ok;
+        values[col] = parseNumber(p, sep, &ok);
+        if (ok)
+            isEmpty = false;
+
+        p = sep + 1;
+    }
+
+    // blank lines, repeated headers ...
+    if (isEmpty)
+        return;
+
+    for (int col = 0; col < numColumns; col++)
+        chunk.columns[col] += values[col];
+}
+
+static void parseChunk(Chunk &chunk)
+{
+    // a rough guess of the number of rows, to avoid reallocations
+    const int numRows = (chunk.end - chunk.begin) / (8 * chunk.numColumns) + 1;
+
+    chunk.columns.resize(chunk.numColumns);
+    for (QVector<double> &column : chunk.columns)
+        column.reserve(numRows);
+
+    const char *p = chunk.begin;
+    while (p < chunk.end) {
+        const char *eol = static_cast<const char *>(
+            std::memchr(p, '\n', chunk.end - p));
+
+        if (eol == nullptr)
+            eol = chunk.end;
+
+        parseLine(p, eol, chunk);
+        p = eol + 1;
+    }
+}
+
+static QList<QByteArray> splitLine(const char *p, const char *eol)
+{
+    QByteArray line(p, eol - p);
+    if (line.endsWith('\r'))
+        line.chop(1);
+
+    return line.split(',');
+}
+
+CsvTable::CsvTable()
+{
+}
+
+void CsvTable::clear()
+{
+    error.clear();
+    names.clear();
+    columns.clear();
+}
+
+bool CsvTable::load(const QString &fileName)
+{
+    clear();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    const qint64 size = file.size();
+
+    bool ok;
+
+    uchar *data = (size > 0) ? file.map(0, size) : nullptr;
+    if (data) {
+        ok = parse(reinterpret_cast<const char *>(data), size);
+        file.unmap(data);
+    } else {
+        // f.e. file systems, that don't support mapping
+        const QByteArray bytes = file.readAll();
+        ok = parse(bytes.constData(), bytes.size());
+    }
+
+    if (!ok)
+        clear();
+
+    return ok;
+}
+
+bool CsvTable::parse(const char *data, qint64 size)
+{
+    const char *end = data + size;
+
+    // the first line: header or already data
+
+    const char *eol = static_cast<const char *>(std::memchr(data, '\n', size));
+    if (eol == nullptr)
+        eol = end;
+
+    const QList<QByteArray> fields = splitLine(data, eol);
+
+    bool isHeader = false;
+    int numColumns = 0;
+
+    for (int i = 0; i < fields.size(); i++) {
+        const QByteArray field = fields[i].trimmed();
+        if (field.isEmpty())
+            continue;
+
+        bool isNumber;
+        parseNumber(field.constData(), field.constData() + field.size(), &isNumber);
+        if (!isNumber)
+            isHeader = true;
+
+        numColumns = i + 1;
+    }
+
+    const char *begin = data;
+
+    if (isHeader) {
+        for (int i = 0; i < numColumns; i++)
+            names += QString::fromUtf8(fields[i].trimmed());
+
+        begin = qMin(eol + 1, end);
+
+        // unnamed columns might have values, what can be found in the first row
+
+        const char *eol2 = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+        const QList<QByteArray> row = splitLine(begin, eol2 ? eol2 : end);
+
+        for (int i = numColumns; i < row.size(); i++) {
+            if (!row[i].trimmed().isEmpty())
+                numColumns = i + 1;
+        }
+    }
+
+    numColumns = qMin(numColumns, 64);
+
+    while (names.size() < numColumns)
+        names += QString();
+
+    if (numColumns == 0) {
+        error = "No columns found";
+        return false;
+    }
+
+    // splitting into chunks at line boundaries
+
+    const qint64 numBytes = end - begin;
+    const int numChunks = qBound(qint64(1), numBytes / MinChunkSize,
+        qint64(4 * qMax(QThread::idealThreadCount(), 1)));
+
+    QVector<Chunk> chunks;
+    chunks.reserve(numChunks);
+
+    const char *chunkBegin = begin;
+    for (int i = 1; i <= numChunks; i++) {
+        const char *chunkEnd = end;
+
+        if (i < numChunks) {
+            chunkEnd = begin + numBytes * i / numChunks;
+            if (chunkEnd < chunkBegin)
+                chunkEnd = chunkBegin;
+
+            const char *nl = static_cast<const char *>(
+                std::memchr(chunkEnd, '\n', end - chunkEnd));
+
+            chunkEnd = nl ? nl + 1 : end;
+        }
+
+        if (chunkEnd > chunkBegin) {
+            Chunk chunk;
+            chunk.begin = chunkBegin;
+            chunk.end = chunkEnd;
+            chunk.numColumns = numColumns;
+
+            chunks += chunk;
+        }
+
+        chunkBegin = chunkEnd;
+    }
+
+    QtConcurrent::blockingMap(chunks, parseChunk);
+
+    // concatenating the chunks in file order
+
+    int numRows = 0;
+    for (const Chunk &chunk : chunks)
+        numRows += chunk.columns.isEmpty() ? 0 : chunk.columns[0].size();
+
+    columns.resize(numColumns);
+    for (int col = 0; col < numColumns; col++) {
+        QVector<double> &column = columns[col];
+        column.reserve(numRows);
+
+        for (const Chunk &chunk : chunks)
+            column += chunk.columns[col];
+    }
+
+    // dropping the unnamed columns without any value
+
+    for (int col = numColumns - 1; col >= 0; col--) {
+        if (!names[col].isEmpty())
+            continue;
+
+        const QVector<double> &column = columns[col];
+
+        bool hasValues = false;
+        for (int row = 0; row < column.size() && !hasValues; row++)
+            hasValues = !std::isnan(column[row]);
+
+        if (!hasValues) {
+            names.removeAt(col);
+            columns.removeAt(col);
+        }
+    }
+
+    for (int col = 0; col < names.size(); col++) {
+        if (names[col].isEmpty())
+            names[col] = QString("column %1").arg(col + 1);
+    }
+
+    if (columns.isEmpty()) {
+        error = "No data found";
+        return false;
+    }
+
+    return true;
+}
+
+QString CsvTable::errorString() const
+{
+    return error;
+}
+
+int CsvTable::rowCount() const
+{
+    return columns.isEmpty() ? 0 : columns[0].size();
+}
+
+int CsvTable::columnCount() const
+{
+    return columns.size();
+}
+
+QString CsvTable::columnName(int column) const
+{
+    return names.value(column);
+}
+
+int CsvTable::columnIndex(const QString &name) const
+{
+    // "MFC_C (V)" can be found as "MFC_C" as well
+
+    for (int col = 0; col < names.size(); col++) {
+        QString columnName = names[col];
+        if (columnName.compare(name, Qt::CaseInsensitive) == 0)
+            return col;
+
+        const int pos = columnName.indexOf('(');
+        if (pos > 0) {
+            columnName = columnName.left(pos).trimmed();
+            if (columnName.compare(name, Qt::CaseInsensitive) == 0)
+                return col;
+        }
+    }
+
+    return -1;
+}
+
+int CsvTable::timeColumn() const
+{
+    const int col = columnIndex("time");
+    if (col >= 0)
+        return col;
+
+    // the VIPER-E firmware writes "time_diff (us)"
+
+    for (int i = 0; i < names.size(); i++) {
+        if (names[i].startsWith("time", Qt::CaseInsensitive))
+            return i;
+    }
+
+    return -1;
+}
+
+const QVector<double> &CsvTable::column(int column) const
+{
+    return columns[column];
+}
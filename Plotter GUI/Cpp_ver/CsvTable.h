@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*
+   Columnar table loaded from a CSV file
+
+   The file is memory mapped and split into chunks at line boundaries,
+   that are parsed in parallel. The rows of the chunks are concatenated
+   in file order afterwards.
+
+   A header line is detected by non numeric fields. Columns without name
+   and without values - like the trailing ",,,,," of the VIPER-E logs -
+   are dropped, empty or invalid fields of the other columns are NaN.
+ */
+class CsvTable
+{
+public:
+    CsvTable();
+
+    bool load(const QString &fileName);
+    void clear();
+
+    QString errorString() const;
+
+    int rowCount() const;
+    int columnCount() const;
+
+    QString columnName(int column) const;
+    int columnIndex(const QString &name) const;
+
+    // "time" or the first column starting with it, like "time_diff (us)"
+    int timeColumn() const;
+
+    const QVector<double> &column(int column) const;
+
+private:
+    bool parse(const char *data, qint64 size);
+
+    QString error;
+    QStringList names;
+    QVector<QVector<double>> columns;
+};
@@ -0,0 +1,32 @@
+#include "EnvelopeCurve.h"
+#include "EnvelopeData.h"
+
+#include <qwt_scale_map.h>
+
+EnvelopeCurve::EnvelopeCurve(const QString &title)
+    : QwtPlotCurve(title)
+{
+    setRenderHint(QwtPlotItem::RenderAntialiased, false);
+    setCurveAttribute(QwtPlotCurve::SortedX);
+}
+
+void EnvelopeCurve::setEnvelopeSamples(const QVector<double> &xValues,
+    const QVector<double> &yValues)
+{
+    setData(new EnvelopeData(xValues, yValues));
+}
+
+void EnvelopeCurve::drawSeries(QPainter *painter,
+    const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+    const QRectF &canvasRect, int from, int to) const
+{
+    const EnvelopeData *envelope = dynamic_cast<const EnvelopeData *>(data());
+    if (envelope) {
+        const double x1 = qMin(xMap.s1(), xMap.s2());
+        const double x2 = qMax(xMap.s1(), xMap.s2());
+
+        envelope->setView(x1, x2, qRound(qAbs(xMap.pDist())));
+    }
+
+    QwtPlotCurve::drawSeries(painter, xMap, yMap, canvasRect, from, to);
+}
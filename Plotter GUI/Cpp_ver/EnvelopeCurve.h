@@ -0,0 +1,25 @@
+#pragma once
+
+#include <qwt_plot_curve.h>
+
+#include <QVector>
+
+/*
+   Curve for logs with millions of samples
+
+   The samples are stored in an EnvelopeData, that is adjusted
+   to the scale maps before each draw operation.
+ */
+class EnvelopeCurve : public QwtPlotCurve
+{
+public:
+    explicit EnvelopeCurve(const QString &title = QString());
+
+    void setEnvelopeSamples(const QVector<double> &xValues,
+        const QVector<double> &yValues);
+
+protected:
+    virtual void drawSeries(QPainter *painter,
+        const QwtScaleMap &xMap, const QwtScaleMap &yMap,
+        const QRectF &canvasRect, int from, int to) const QWT_OVERRIDE;
+};
@@ -0,0 +1,189 @@
+#include "EnvelopeData.h"
+
+#include <algorithm>
+#include <limits>
+
+// number of buckets of a level, that are combined into one bucket
+static const int LevelShift = 2;
+static const int LevelFactor = 1 << LevelShift;
+
+EnvelopeData::EnvelopeData(const QVector<double> &xValues, const QVector<double> &yValues)
+    : xData(xValues)
+    , yData(yValues)
+    , currentLevel(0)
+    , first(0)
+    , count(0)
+{
+    const int numSamples = qMin(xData.size(), yData.size());
+    xData.resize(numSamples);
+    yData.resize(numSamples);
+
+    count = numSamples;
+
+    build();
+}
+
+void EnvelopeData::build()
+{
+    const int numSamples = xData.size();
+
+    double yMin = std::numeric_limits<double>::max();
+    double yMax = -std::numeric_limits<double>::max();
+
+    // the first level from the samples, NaNs are ignored
+
+    QVector<Bucket> buckets;
+    buckets.reserve(numSamples / LevelFactor + 1);
+
+    for (int i = 0; i < numSamples; i += LevelFactor) {
+        const int end = qMin(i + LevelFactor, numSamples);
+
+        Bucket bucket;
+        bucket.lowX = bucket.highX = xData[i];
+        bucket.low = std::numeric_limits<double>::max();
+        bucket.high = -std::numeric_limits<double>::max();
+
+        for (int j = i; j < end; j++) {
+            const double y = yData[j];
+
+            if (y < bucket.low) {
+                bucket.low = y;
+                bucket.lowX = xData[j];
+            }
+
+            if (y > bucket.high) {
+                bucket.high = y;
+                bucket.highX = xData[j];
+            }
+        }
+
+        if (bucket.low > bucket.high) {
+            bucket.low = bucket.high = qQNaN();
+        } else {
+            yMin = qMin(yMin, bucket.low);
+            yMax = qMax(yMax, bucket.high);
+        }
+
+        buckets += bucket;
+    }
+
+    // the coarser levels from the level below, until
+    // there is nothing left to combine
+
+    while (buckets.size() > 1) {
+        levels += buckets;
+
+        const QVector<Bucket> &below = levels.last();
+
+        buckets.clear();
+        buckets.reserve(below.size() / LevelFactor + 1);
+
+        for (int i = 0; i < below.size(); i += LevelFactor) {
+            const int end = qMin(i + LevelFactor, below.size());
+
+            Bucket bucket = below[i];
+            for (int j = i + 1; j < end; j++) {
+                const Bucket &b = below[j];
+
+                if (b.low < bucket.low || qIsNaN(bucket.low)) {
+                    bucket.low = b.low;
+                    bucket.lowX = b.lowX;
+                }
+
+                if (b.high > bucket.high || qIsNaN(bucket.high)) {
+                    bucket.high = b.high;
+                    bucket.highX = b.highX;
+                }
+            }
+
+            buckets += bucket;
+        }
+    }
+
+    if (numSamples > 0 && yMin <= yMax) {
+        bounds.setCoords(xData.first(), yMin, xData.last(), yMax);
+    } else {
+        bounds = QRectF(1.0, 1.0, -2.0, -2.0); // invalid
+    }
+}
+
+void EnvelopeData::setView(double x1, double x2, int pixels) const
+{
+    pixels = qMax(pixels, 1);
+
+    // the visible samples and one more on each side, so
+    // that the lines continue to the borders of the canvas
+
+    const double *values = xData.constData();
+    const int numSamples = xData.size();
+
+    int from = std::lower_bound(values, values + numSamples, x1) - values;
+    int to = std::upper_bound(values, values + numSamples, x2) - values;
+
+    from = qMax(from - 1, 0);
+    to = qMin(to + 1, numSamples);
+
+    const int numVisible = qMax(to - from, 0);
+
+    // 2 points per bucket: the raw samples are good enough as long
+    // as there are no more than 2 of them for each pixel. Otherwise
+    // the coarsest level, that still has one bucket per pixel
+
+    int level = 0;
+    if (numVisible > 2 * pixels) {
+        while (level < levels.size()
+               && (numVisible >> (LevelShift * (level + 1))) >= pixels) {
+            level++;
+        }
+    }
+
+    currentLevel = level;
+
+    if (level == 0) {
+        first = from;
+        count = numVisible;
+    } else {
+        const int shift = LevelShift * level;
+
+        first = from >> shift;
+        count = numVisible > 0 ? 2 * (((to - 1) >> shift) - (from >> shift) + 1) : 0;
+    }
+}
+
+int EnvelopeData::levelCount() const
+{
+    return levels.size() + 1;
+}
+
+int EnvelopeData::level() const
+{
+    return currentLevel;
+}
+
+size_t EnvelopeData::size() const
+{
+    return count;
+}
+
+QPointF EnvelopeData::sample(size_t index) const
+{
+    if (currentLevel == 0) {
+        const int i = static_cast<int>(first + index);
+        return QPointF(xData[i], yData[i]);
+    }
+
+    const Bucket &bucket = levels[currentLevel - 1][static_cast<int>(first + index / 2)];
+
+    // the extremes in the order of their appearance
+    const bool lowFirst = bucket.lowX <= bucket.highX;
+
+    if ((index % 2 == 0) == lowFirst)
+        return QPointF(bucket.lowX, bucket.low);
+
+    return QPointF(bucket.highX, bucket.high);
+}
+
+QRectF EnvelopeData::boundingRect() const
+{
+    return bounds;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <qwt_series_data.h>
+
+#include <QVector>
+
+/*
+   Series data of a long flight log with a min/max level of detail pyramid
+
+   Every level combines 4 buckets of the level below into one bucket,
+   that remembers the minimum and the maximum together with their
+   positions. A bucket is displayed as 2 points, so that spikes - like
+   the solenoid transient - are never lost, whatever the zoom level.
+
+   setView() selects the coarsest level with at least one bucket per
+   pixel and restricts the samples to the visible range. Then the cost
+   of drawing depends on the width of the canvas, but not on the
+   number of samples. The x values have to be increasing.
+ */
+class EnvelopeData : public QwtSeriesData<QPointF>
+{
+public:
+    EnvelopeData(const QVector<double> &xValues, const QVector<double> &yValues);
+
+    void setView(double x1, double x2, int pixels) const;
+
+    int levelCount() const;
+    int level() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample(size_t index) const QWT_OVERRIDE;
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+private:
+    struct Bucket
+    {
+        double lowX;
+        double low;
+        double highX;
+        double high;
+    };
+
+    void build();
+
+    QVector<double> xData;
+    QVector<double> yData;
+
+    // levels[k] has 4^(k+1) samples per bucket
+    QVector<QVector<Bucket>> levels;
+
+    QRectF bounds;
+
+    // the view is set when drawing, what is a const operation
+    mutable int currentLevel;
+    mutable size_t first;
+    mutable size_t count;
+};
@@ -0,0 +1,468 @@
+#include "SerialPlotter.h"
+#include "SpectrumAnalyzer.h"
+#include "WaterfallData.h"
+#include "TelemetryPlayer.h"
+#include "CsvTable.h"
+#include "EnvelopeCurve.h"
+
+#include <qwt_plot.h>
+#include <qwt_plot_curve.h>
+#include <qwt_point_data.h>
+#include <qwt_plot_spectrogram.h>
+#include <qwt_color_map.h>
+
+#include <QtWidgets>
+#include <QSerialPortInfo>
+
+#include <cmath>
+
+// VIPER-E prints the time in ms
+static const double LiveTimeScale = 1.0e-3;
+
+static const double ReplaySpeeds[] = { 1.0, 2.0, 5.0, 10.0, 50.0 };
+
+// resolution of the position slider
+static const int SliderSteps = 1000;
+
+SerialPlotter::SerialPlotter(QWidget *parent)
+    : QWidget(parent)
+    , secondsPerUnit(LiveTimeScale)
+    , lastTime(qQNaN())
+    , meanInterval(0.0)
+    , reportedRate(0.0)
+{
+    // Create a Qwt plot
+    plot = new QwtPlot(this);
+    plot->setCanvasBackground(Qt::white);
+
+    // Create a curve to display data
+    curve = new QwtPlotCurve();
+    curve->attach(plot);
+    curve->setPen(Qt::blue);
+    curve->setCurveAttribute(QwtPlotCurve::SortedX); // frames arrive in time order
+
+    // autoscaling needs the bounding rect for every replot
+    liveData = new QwtAppendablePointData();
+    curve->setData(liveData);
+
+    // Curve for complete flight logs
+    logCurve = new EnvelopeCurve();
+    logCurve->attach(plot);
+    logCurve->setPen(Qt::darkGreen);
+
+    // Amplitude spectrum of the most recent window
+    spectrumPlot = new QwtPlot(this);
+    spectrumPlot->setCanvasBackground(Qt::white);
+    spectrumPlot->setAxisTitle(QwtAxis::XBottom, "Frequency (Hz)");
+    spectrumPlot->setAxisTitle(QwtAxis::YLeft, "Amplitude (V)");
+
+    spectrumCurve = new QwtPlotCurve();
+    spectrumCurve->attach(spectrumPlot);
+    spectrumCurve->setPen(Qt::red);
+
+    // Waterfall of the spectra, the most recent one on top
+    waterfallPlot = new QwtPlot(this);
+    waterfallPlot->setAxisTitle(QwtAxis::XBottom, "Frequency (Hz)");
+    waterfallPlot->setAxisTitle(QwtAxis::YLeft, "Age (s)");
+
+    QwtLinearColorMap *colorMap = new QwtLinearColorMap(Qt::darkBlue, Qt::red);
+    colorMap->addColorStop(0.3, Qt::cyan);
+    colorMap->addColorStop(0.6, Qt::green);
+    colorMap->addColorStop(0.8, Qt::yellow);
+    colorMap->setLookupTableSize(1024); // 0.1 dB steps
+
+    waterfallData = new WaterfallData();
+    waterfallData->setValueRange(QwtInterval(-100.0, 0.0)); // dBV
+
+    waterfall = new QwtPlotSpectrogram();
+    waterfall->setRenderThreadCount(0); // use system specific thread count
+    waterfall->setColorMap(colorMap);
+    waterfall->setData(waterfallData);
+    waterfall->attach(waterfallPlot);
+
+    spectrumBox = new QCheckBox("Spectrum", this);
+    spectrumBox->setChecked(true);
+    connect(spectrumBox, &QCheckBox::toggled, this, &SerialPlotter::setSpectrumVisible);
+
+    // Recording of the serial port and replay of recordings or CSV files
+    player = new TelemetryPlayer(this);
+    connect(player, &TelemetryPlayer::framesReady, this, &SerialPlotter::ingestLines);
+    connect(player, &TelemetryPlayer::positionChanged, this, &SerialPlotter::updatePosition);
+    connect(player, &TelemetryPlayer::finished, this, &SerialPlotter::replayFinished);
+
+    recordButton = new QPushButton("Record", this);
+    recordButton->setCheckable(true);
+    connect(recordButton, &QPushButton::toggled, this, &SerialPlotter::setRecording);
+
+    replayButton = new QPushButton("Replay", this);
+    replayButton->setCheckable(true);
+    connect(replayButton, &QPushButton::toggled, this, &SerialPlotter::setReplay);
+
+    playButton = new QPushButton("Play", this);
+    playButton->setCheckable(true);
+    playButton->setEnabled(false);
+    connect(playButton, &QPushButton::toggled, this, &SerialPlotter::setPlaying);
+
+    speedBox = new QComboBox(this);
+    for (double speed : ReplaySpeeds)
+        speedBox->addItem(QString("%1x").arg(speed));
+    speedBox->setEnabled(false);
+    connect(speedBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+        this, &SerialPlotter::setSpeedIndex);
+
+    loadButton = new QPushButton("Load log", this);
+    connect(loadButton, &QPushButton::clicked, this, &SerialPlotter::loadLog);
+
+    positionSlider = new QSlider(Qt::Horizontal, this);
+    positionSlider->setRange(0, SliderSteps);
+    positionSlider->setEnabled(false);
+    connect(positionSlider, &QSlider::sliderMoved, this, &SerialPlotter::seekReplay);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    controls->addWidget(spectrumBox);
+    controls->addWidget(recordButton);
+    controls->addWidget(replayButton);
+    controls->addWidget(playButton);
+    controls->addWidget(speedBox);
+    controls->addWidget(loadButton);
+    controls->addWidget(positionSlider, 1);
+
+    // Layout
+    QVBoxLayout *layout = new QVBoxLayout();
+    layout->addLayout(controls);
+    layout->addWidget(plot);
+    layout->addWidget(spectrumPlot);
+    layout->addWidget(waterfallPlot);
+    setLayout(layout);
+
+    // The FFTs are calculated in a worker thread
+    analyzer = new SpectrumAnalyzer();
+    analyzer->moveToThread(&analyzerThread);
+
+    connect(&analyzerThread, &QThread::finished, analyzer, &QObject::deleteLater);
+    connect(this, &SerialPlotter::sampleRateChanged, analyzer, &SpectrumAnalyzer::setSampleRate);
+    connect(this, &SerialPlotter::samplesReady, analyzer, &SpectrumAnalyzer::appendSamples);
+    connect(analyzer, &SpectrumAnalyzer::spectrumReady, this, &SerialPlotter::updateSpectrum);
+
+    analyzerThread.start();
+
+    // Open the serial port
+    const QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
+    for (const QSerialPortInfo &info : ports) {
+        if (info.description().contains("USB")) { // Adjust this according to your device's description
+            serialPort.setPortName(info.portName());
+            if (serialPort.open(QIODevice::ReadOnly)) {
+                qDebug() << "Serial port opened:" << info.portName();
+                break;
+            } else {
+                qDebug() << "Failed to open serial port:" << info.portName();
+            }
+        }
+    }
+
+    // Connect signals and slots
+    connect(&serialPort, &QSerialPort::readyRead, this, &SerialPlotter::readData);
+}
+
+SerialPlotter::~SerialPlotter()
+{
+    serialPort.close();
+    recorder.close();
+
+    analyzerThread.quit();
+    analyzerThread.wait();
+}
+
+void SerialPlotter::setTimeScale(double scale)
+{
+    if (scale > 0.0 && scale != secondsPerUnit) {
+        secondsPerUnit = scale;
+        lastTime = qQNaN();
+        meanInterval = 0.0;
+    }
+}
+
+double SerialPlotter::timeScale() const
+{
+    return secondsPerUnit;
+}
+
+void SerialPlotter::setSpectrumVisible(bool on)
+{
+    spectrumPlot->setVisible(on);
+    waterfallPlot->setVisible(on);
+
+    if (!on) {
+        QMetaObject::invokeMethod(analyzer, "reset", Qt::QueuedConnection);
+        waterfallData->clear();
+    }
+}
+
+void SerialPlotter::clear()
+{
+    liveData->clear();
+    pendingSamples.clear();
+
+    lastTime = qQNaN();
+    meanInterval = 0.0;
+
+    logCurve->setSamples(QVector<QPointF>());
+    plot->replot();
+
+    QMetaObject::invokeMethod(analyzer, "reset", Qt::QueuedConnection);
+
+    waterfallData->clear();
+    waterfallPlot->replot();
+}
+
+void SerialPlotter::readData()
+{
+    QList<QByteArray> lines;
+    while (serialPort.canReadLine()) {
+        const QByteArray line = serialPort.readLine();
+        recorder.record(line);
+
+        lines += line;
+    }
+
+    // during a replay the live data is recorded, but not displayed
+    if (!lines.isEmpty() && !player->isOpen())
+        ingestLines(lines);
+}
+
+void SerialPlotter::setRecording(bool on)
+{
+    if (!on) {
+        recorder.close();
+        return;
+    }
+
+    const QString fileName = QFileDialog::getSaveFileName(this,
+        "Record telemetry", QString(), "Telemetry recordings (*.vpr)");
+
+    if (fileName.isEmpty() || !recorder.open(fileName)) {
+        QSignalBlocker blocker(recordButton);
+        recordButton->setChecked(false);
+    }
+}
+
+void SerialPlotter::setReplay(bool on)
+{
+    if (on) {
+        const QString fileName = QFileDialog::getOpenFileName(this,
+            "Replay telemetry", QString(),
+            "Telemetry (*.vpr *.csv);;All files (*)");
+
+        if (fileName.isEmpty() || !player->open(fileName)) {
+            QSignalBlocker blocker(replayButton);
+            replayButton->setChecked(false);
+            return;
+        }
+
+        // CSV files have their own time unit, recordings
+        // contain the frames as they came from the device
+
+        clear();
+        setTimeScale(player->format() == TelemetryPlayer::Csv
+            ? player->csvTimeScale() : LiveTimeScale);
+    } else {
+        player->close();
+
+        clear();
+        setTimeScale(LiveTimeScale);
+    }
+
+    playButton->setEnabled(on);
+    speedBox->setEnabled(on);
+    positionSlider->setEnabled(on);
+    positionSlider->setValue(0);
+
+    playButton->setChecked(on);
+}
+
+void SerialPlotter::setPlaying(bool on)
+{
+    if (on) {
+        // play() restarts at the end, where the curve would not be sorted anymore
+        if (player->position() >= player->duration())
+            clear();
+
+        player->play();
+    } else {
+        player->pause();
+    }
+}
+
+void SerialPlotter::setSpeedIndex(int index)
+{
+    if (index >= 0)
+        player->setSpeed(ReplaySpeeds[index]);
+}
+
+void SerialPlotter::seekReplay(int value)
+{
+    // the history would not be continuous anymore
+    clear();
+
+    player->seek(player->duration() * value / SliderSteps);
+}
+
+void SerialPlotter::loadLog()
+{
+    const QString fileName = QFileDialog::getOpenFileName(this,
+        "Load flight log", QString(), "CSV files (*.csv);;All files (*)");
+
+    if (fileName.isEmpty())
+        return;
+
+    CsvTable table;
+    if (!table.load(fileName)) {
+        QMessageBox::warning(this, "Load flight log", table.errorString());
+        return;
+    }
+
+    replayButton->setChecked(false);
+    clear();
+
+    // the complete log at once: "time_diff (us), MFC_C, MFC_E" or values only
+
+    const int timeColumn = table.timeColumn();
+
+    int valueColumn = 0;
+    while (valueColumn == timeColumn)
+        valueColumn++;
+
+    if (valueColumn >= table.columnCount())
+        return;
+
+    const QVector<double> values = table.column(valueColumn);
+
+    QVector<double> times;
+    if (timeColumn >= 0) {
+        const double scale = player->csvTimeScale();
+
+        times = table.column(timeColumn);
+        for (double &x : times)
+            x *= scale;
+    } else {
+        times.resize(values.size());
+        for (int i = 0; i < times.size(); i++)
+            times[i] = i;
+    }
+
+    // millions of samples: drawn from a min/max pyramid
+    logCurve->setTitle(table.columnName(valueColumn));
+    logCurve->setEnvelopeSamples(times, values);
+
+    plot->replot();
+}
+
+void SerialPlotter::updatePosition(double position)
+{
+    if (positionSlider->isSliderDown() || player->duration() <= 0.0)
+        return;
+
+    QSignalBlocker blocker(positionSlider);
+    positionSlider->setValue(qRound(position / player->duration() * SliderSteps));
+}
+
+void SerialPlotter::replayFinished()
+{
+    QSignalBlocker blocker(playButton);
+    playButton->setChecked(false);
+}
+
+void SerialPlotter::ingestLines(const QList<QByteArray> &lines)
+{
+    for (const QByteArray &line : lines)
+        ingestLine(line);
+
+    if (pendingSamples.isEmpty())
+        return;
+
+    plot->replot();
+
+    if (meanInterval > 0.0) {
+        // the real sample rate of the device, not the baud rate
+        const double rate = 1.0 / meanInterval;
+        if (qAbs(rate - reportedRate) > 0.01 * reportedRate) {
+            reportedRate = rate;
+            Q_EMIT sampleRateChanged(rate);
+        }
+    }
+
+    if (spectrumBox->isChecked())
+        Q_EMIT samplesReady(pendingSamples);
+
+    pendingSamples.clear();
+}
+
+void SerialPlotter::ingestLine(const QByteArray &line)
+{
+    // frames are "time, value [, value ...]" or a single value,
+    // separated by commas and/or whitespace
+
+    QByteArray normalized = line;
+    normalized.replace(',', ' ');
+
+    QVector<double> fields;
+
+    const QList<QByteArray> tokens = normalized.simplified().split(' ');
+    for (const QByteArray &token : tokens) {
+        bool ok;
+        const double value = token.toDouble(&ok);
+        if (ok)
+            fields += value;
+    }
+
+    if (fields.isEmpty())
+        return;
+
+    double x;
+    double y;
+
+    if (fields.size() == 1) {
+        x = liveData->size();
+        y = fields[0];
+    } else {
+        x = fields[0] * secondsPerUnit;
+        y = fields[1];
+
+        if (!qIsNaN(lastTime) && x > lastTime) {
+            const double dt = x - lastTime;
+            meanInterval = (meanInterval > 0.0) ? 0.95 * meanInterval + 0.05 * dt : dt;
+        }
+
+        lastTime = x;
+    }
+
+    liveData->append(QPointF(x, y));
+    pendingSamples.append(y);
+}
+
+void SerialPlotter::updateSpectrum(const QVector<double> &amplitudes,
+    double binWidth, double interval)
+{
+    const int numBins = amplitudes.size();
+
+    QVector<double> frequencies(numBins);
+    QVector<double> levels(numBins);
+
+    for (int i = 0; i < numBins; i++) {
+        frequencies[i] = i * binWidth;
+        levels[i] = 20.0 * std::log10(qMax(amplitudes[i], 1.0e-12));
+    }
+
+    spectrumCurve->setSamples(frequencies, amplitudes);
+    spectrumPlot->setAxisScale(QwtAxis::XBottom, 0.0, numBins * binWidth);
+    spectrumPlot->replot();
+
+    waterfallData->appendRow(levels, binWidth, interval);
+
+    const QwtInterval xInterval = waterfallData->interval(Qt::XAxis);
+    const QwtInterval yInterval = waterfallData->interval(Qt::YAxis);
+
+    waterfallPlot->setAxisScale(QwtAxis::XBottom, xInterval.minValue(), xInterval.maxValue());
+    waterfallPlot->setAxisScale(QwtAxis::YLeft, yInterval.minValue(), yInterval.maxValue());
+    waterfallPlot->replot();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QWidget>
+#include <QSerialPort>
+#include <QThread>
+#include <QVector>
+#include <QList>
+#include <QByteArray>
+
+#include "TelemetryRecorder.h"
+
+class QwtPlot;
+class QwtPlotCurve;
+class QwtPlotSpectrogram;
+class QwtAppendablePointData;
+class QCheckBox;
+class QPushButton;
+class QComboBox;
+class QSlider;
+class EnvelopeCurve;
+class SpectrumAnalyzer;
+class WaterfallData;
+class TelemetryPlayer;
+
+class SerialPlotter : public QWidget
+{
+    Q_OBJECT
+
+public:
+    SerialPlotter(QWidget *parent = nullptr);
+    ~SerialPlotter();
+
+    // seconds per unit of the time column of a frame
+    void setTimeScale(double scale);
+    double timeScale() const;
+
+public Q_SLOTS:
+    void ingestLines(const QList<QByteArray> &lines);
+    void clear();
+    void setSpectrumVisible(bool on);
+
+Q_SIGNALS:
+    void samplesReady(const QVector<double> &samples);
+    void sampleRateChanged(double rate);
+
+private Q_SLOTS:
+    void readData();
+    void setRecording(bool on);
+    void setReplay(bool on);
+    void setPlaying(bool on);
+    void setSpeedIndex(int index);
+    void seekReplay(int value);
+    void loadLog();
+    void updatePosition(double position);
+    void replayFinished();
+    void updateSpectrum(const QVector<double> &amplitudes,
+        double binWidth, double interval);
+
+private:
+    void ingestLine(const QByteArray &line);
+
+    QSerialPort serialPort;
+    QwtPlot *plot;
+    QwtPlotCurve *curve;
+    QwtAppendablePointData *liveData; // owned by curve
+    EnvelopeCurve *logCurve;
+
+    // time of the previous frame and the averaged sample interval
+    double secondsPerUnit;
+    double lastTime;
+    double meanInterval;
+    double reportedRate;
+    QVector<double> pendingSamples;
+
+    QCheckBox *spectrumBox;
+    QwtPlot *spectrumPlot;
+    QwtPlotCurve *spectrumCurve;
+    QwtPlot *waterfallPlot;
+    QwtPlotSpectrogram *waterfall;
+    WaterfallData *waterfallData;
+
+    QThread analyzerThread;
+    SpectrumAnalyzer *analyzer;
+
+    TelemetryRecorder recorder;
+    TelemetryPlayer *player;
+
+    QPushButton *recordButton;
+    QPushButton *replayButton;
+    QPushButton *playButton;
+    QComboBox *speedBox;
+    QPushButton *loadButton;
+    QSlider *positionSlider;
+};
@@ -0,0 +1,166 @@
+#include "SpectrumAnalyzer.h"
+
+#include <QtMath>
+
+#include <utility>
+
+// When the worker falls behind ( f.e. replaying at high speed ) older
+// windows are dropped, so that the display always shows recent data
+static const int MaxPendingWindows = 8;
+
+// in place radix-2 decimation in time, n has to be a power of 2
+static void fft(std::complex<double> *data, int n,
+    const std::complex<double> *twiddles)
+{
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    for (int len = 2; len <= n; len <<= 1) {
+        const int half = len >> 1;
+        const int step = n / len;
+
+        for (int i = 0; i < n; i += len) {
+            for (int k = 0; k < half; k++) {
+                const std::complex<double> u = data[i + k];
+                const std::complex<double> v = data[i + k + half] * twiddles[k * step];
+
+                data[i + k] = u + v;
+                data[i + k + half] = u - v;
+            }
+        }
+    }
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer(QObject *parent)
+    : QObject(parent)
+    , size(1024)
+    , overlapRatio(0.5)
+    , rate(1000.0)
+    , windowSum(0.0)
+{
+    initTables();
+}
+
+int SpectrumAnalyzer::fftSize() const
+{
+    return size;
+}
+
+double SpectrumAnalyzer::overlap() const
+{
+    return overlapRatio;
+}
+
+double SpectrumAnalyzer::sampleRate() const
+{
+    return rate;
+}
+
+void SpectrumAnalyzer::setFftSize(int length)
+{
+    // round up to the next power of 2
+    int n = 16;
+    while (n < length && n < (1 << 20))
+        n <<= 1;
+
+    if (n != size) {
+        size = n;
+        initTables();
+    }
+}
+
+void SpectrumAnalyzer::setOverlap(double ratio)
+{
+    overlapRatio = qBound(0.0, ratio, 0.95);
+}
+
+void SpectrumAnalyzer::setSampleRate(double value)
+{
+    if (value > 0.0)
+        rate = value;
+}
+
+void SpectrumAnalyzer::reset()
+{
+    pending.clear();
+}
+
+void SpectrumAnalyzer::appendSamples(const QVector<double> &samples)
+{
+    pending += samples;
+
+    const int hop = hopSize();
+
+    int offset = 0;
+
+    const int numWindows = (pending.size() - size) / hop + 1;
+    if (numWindows > MaxPendingWindows)
+        offset = (numWindows - MaxPendingWindows) * hop;
+
+    for (; offset + size <= pending.size(); offset += hop)
+        transform(pending.constData() + offset);
+
+    if (offset > 0)
+        pending.remove(0, qMin(offset, pending.size()));
+}
+
+int SpectrumAnalyzer::hopSize() const
+{
+    return qMax(1, qRound(size * (1.0 - overlapRatio)));
+}
+
+void SpectrumAnalyzer::initTables()
+{
+    window.resize(size);
+    windowSum = 0.0;
+
+    for (int i = 0; i < size; i++) {
+        window[i] = 0.5 * (1.0 - qCos(2.0 * M_PI * i / (size - 1)));
+        windowSum += window[i];
+    }
+
+    twiddles.resize(size / 2);
+    for (int k = 0; k < size / 2; k++)
+        twiddles[k] = std::polar(1.0, -2.0 * M_PI * k / size);
+
+    pending.clear();
+}
+
+void SpectrumAnalyzer::transform(const double *samples)
+{
+    Q_EMIT spectrumReady(spectrum(samples), rate / size, hopSize() / rate);
+}
+
+QVector<double> SpectrumAnalyzer::spectrum(const double *samples) const
+{
+    // removing the mean, otherwise the DC offset of the
+    // sensors leaks into the lower bins
+
+    double mean = 0.0;
+    for (int i = 0; i < size; i++)
+        mean += samples[i];
+    mean /= size;
+
+    QVector<std::complex<double>> buffer(size);
+    for (int i = 0; i < size; i++)
+        buffer[i] = std::complex<double>((samples[i] - mean) * window[i], 0.0);
+
+    fft(buffer.data(), size, twiddles.constData());
+
+    const int numBins = size / 2;
+
+    QVector<double> amplitudes(numBins);
+    for (int k = 0; k < numBins; k++) {
+        const double factor = (k == 0) ? 1.0 : 2.0;
+        amplitudes[k] = factor * std::abs(buffer[k]) / windowSum;
+    }
+
+    return amplitudes;
+}
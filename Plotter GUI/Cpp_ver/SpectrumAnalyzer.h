@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+#include <complex>
+
+/*
+   Sliding window FFT of the incoming samples.
+
+   The analyzer is meant to live in a worker thread: samples and settings
+   arrive through queued slot invocations and every completed window is
+   reported with spectrumReady(). Windows are Hann weighted and overlap
+   by overlap() of their length.
+ */
+class SpectrumAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumAnalyzer(QObject *parent = nullptr);
+
+    int fftSize() const;
+    double overlap() const;
+    double sampleRate() const;
+
+    // single sided amplitude spectrum of fftSize() samples
+    QVector<double> spectrum(const double *samples) const;
+
+public Q_SLOTS:
+    void setFftSize(int length);
+    void setOverlap(double ratio);
+    void setSampleRate(double value);
+
+    void appendSamples(const QVector<double> &samples);
+    void reset();
+
+Q_SIGNALS:
+    /*
+       amplitudes: single sided amplitude spectrum, bin k covers
+                   [k * binWidth, (k + 1) * binWidth[
+       interval:   time between two consecutive spectra in seconds
+     */
+    void spectrumReady(const QVector<double> &amplitudes,
+        double binWidth, double interval);
+
+private:
+    void initTables();
+    void transform(const double *samples);
+    int hopSize() const;
+
+    int size;
+    double overlapRatio;
+    double rate;
+
+    QVector<double> pending;
+    QVector<double> window;
+    double windowSum;
+
+    QVector<std::complex<double>> twiddles;
+};
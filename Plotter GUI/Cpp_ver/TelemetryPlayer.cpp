@@ -0,0 +1,417 @@
+#include "TelemetryPlayer.h"
+#include "TelemetryRecorder.h"
+
+#include <algorithm>
+
+// every n-th line of a CSV file is added to the index
+static const int CsvIndexInterval = 1024;
+
+// tag, startTime, numFrames, numBytes
+static const int ChunkHeaderSize = 20;
+
+TelemetryPlayer::TelemetryPlayer(QObject *parent)
+    : QObject(parent)
+    , fileFormat(NoFormat)
+    , dataEnd(0)
+    , startTime(0.0)
+    , endTime(0.0)
+    , timeScale(1.0e-6) // VIPER-E logs the time in us
+    , chunkStart(0.0)
+    , chunkFramesLeft(0)
+    , nextTime(0.0)
+    , hasNext(false)
+    , playbackSpeed(1.0)
+    , current(0.0)
+{
+    timer.setInterval(20);
+    connect(&timer, &QTimer::timeout, this, &TelemetryPlayer::tick);
+}
+
+TelemetryPlayer::~TelemetryPlayer()
+{
+    close();
+}
+
+bool TelemetryPlayer::open(const QString &fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    stream.setDevice(&file);
+
+    quint32 tag = 0;
+    stream >> tag;
+
+    bool ok;
+    if (tag == TelemetryRecorder::FileTag) {
+        fileFormat = Recording;
+        ok = openRecording();
+    } else {
+        fileFormat = Csv;
+        ok = openCsv();
+    }
+
+    if (!ok || index.isEmpty()) {
+        close();
+        return false;
+    }
+
+    seek(0.0);
+    return true;
+}
+
+void TelemetryPlayer::close()
+{
+    pause();
+
+    stream.setDevice(nullptr);
+    file.close();
+
+    fileFormat = NoFormat;
+    index.clear();
+    dataEnd = 0;
+    startTime = endTime = 0.0;
+    chunkFramesLeft = 0;
+    hasNext = false;
+    current = 0.0;
+}
+
+bool TelemetryPlayer::isOpen() const
+{
+    return fileFormat != NoFormat;
+}
+
+TelemetryPlayer::Format TelemetryPlayer::format() const
+{
+    return fileFormat;
+}
+
+void TelemetryPlayer::setCsvTimeScale(double scale)
+{
+    if (scale > 0.0)
+        timeScale = scale;
+}
+
+double TelemetryPlayer::csvTimeScale() const
+{
+    return timeScale;
+}
+
+double TelemetryPlayer::duration() const
+{
+    return endTime - startTime;
+}
+
+double TelemetryPlayer::position() const
+{
+    return current;
+}
+
+double TelemetryPlayer::speed() const
+{
+    return playbackSpeed;
+}
+
+bool TelemetryPlayer::isPlaying() const
+{
+    return timer.isActive();
+}
+
+void TelemetryPlayer::play()
+{
+    if (!isOpen() || isPlaying())
+        return;
+
+    // the receiver has to clear its history before restarting
+    if (current >= duration())
+        seek(0.0);
+
+    clock.start();
+    timer.start();
+}
+
+void TelemetryPlayer::pause()
+{
+    timer.stop();
+}
+
+void TelemetryPlayer::setSpeed(double speed)
+{
+    if (speed > 0.0)
+        playbackSpeed = speed;
+}
+
+void TelemetryPlayer::seek(double position)
+{
+    if (index.isEmpty())
+        return;
+
+    position = qBound(0.0, position, duration());
+    const double target = startTime + position;
+
+    // the last chunk starting before the target
+    auto it = std::upper_bound(index.constBegin(), index.constEnd(), target,
+        [](double time, const IndexEntry &entry) { return time < entry.time; });
+
+    if (it != index.constBegin())
+        --it;
+
+    rewind(it->offset);
+
+    while ((hasNext = readFrame(nextFrame, nextTime))) {
+        if (nextTime >= target)
+            break;
+    }
+
+    current = position;
+    clock.restart();
+
+    Q_EMIT positionChanged(current);
+}
+
+void TelemetryPlayer::tick()
+{
+    current += clock.nsecsElapsed() * 1.0e-9 * playbackSpeed;
+    clock.restart();
+
+    const double limit = startTime + current;
+
+    QList<QByteArray> frames;
+
+    for (;;) {
+        if (!hasNext) {
+            hasNext = readFrame(nextFrame, nextTime);
+            if (!hasNext)
+                break;
+        }
+
+        if (nextTime > limit)
+            break;
+
+        frames += nextFrame;
+        hasNext = false;
+    }
+
+    if (!frames.isEmpty())
+        Q_EMIT framesReady(frames);
+
+    if (!hasNext) {
+        pause();
+
+        current = duration();
+        Q_EMIT positionChanged(current);
+        Q_EMIT finished();
+
+        return;
+    }
+
+    Q_EMIT positionChanged(current);
+}
+
+bool TelemetryPlayer::openRecording()
+{
+    quint32 version = 0;
+    stream >> version;
+
+    if (stream.status() != QDataStream::Ok || version != TelemetryRecorder::Version)
+        return false;
+
+    if (!readIndex())
+        rebuildIndex();
+
+    if (index.isEmpty())
+        return false;
+
+    startTime = index.first().time;
+
+    // the time of the last frame can be found in the last chunk
+    rewind(index.last().offset);
+
+    QByteArray frame;
+    double time;
+    while (readFrame(frame, time))
+        endTime = time;
+
+    return true;
+}
+
+bool TelemetryPlayer::readIndex()
+{
+    const qint64 size = file.size();
+    if (size < 8 + TelemetryRecorder::TrailerSize)
+        return false;
+
+    file.seek(size - TelemetryRecorder::TrailerSize);
+    stream.resetStatus();
+
+    qint64 indexOffset = 0;
+    quint32 tag = 0;
+    stream >> indexOffset >> tag;
+
+    if (tag != TelemetryRecorder::TrailerTag || indexOffset < 8 || indexOffset >= size)
+        return false;
+
+    file.seek(indexOffset);
+
+    quint32 count = 0;
+    stream >> tag >> count;
+
+    if (tag != TelemetryRecorder::IndexTag)
+        return false;
+
+    index.clear();
+    index.reserve(count);
+
+    for (quint32 i = 0; i < count; i++) {
+        qint64 time, offset;
+        stream >> time >> offset;
+
+        IndexEntry entry;
+        entry.time = time * 1.0e-6;
+        entry.offset = offset;
+        index += entry;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        index.clear();
+        return false;
+    }
+
+    dataEnd = indexOffset;
+    return true;
+}
+
+void TelemetryPlayer::rebuildIndex()
+{
+    // the recording has not been closed properly: walking
+    // along the chunk headers, without reading the frames
+
+    index.clear();
+
+    const qint64 size = file.size();
+
+    qint64 pos = 8;
+    while (pos + ChunkHeaderSize <= size) {
+        file.seek(pos);
+        stream.resetStatus();
+
+        quint32 tag, numFrames, numBytes;
+        qint64 start;
+        stream >> tag >> start >> numFrames >> numBytes;
+
+        if (tag != TelemetryRecorder::ChunkTag || pos + ChunkHeaderSize + numBytes > size)
+            break;
+
+        IndexEntry entry;
+        entry.time = start * 1.0e-6;
+        entry.offset = pos;
+        index += entry;
+
+        pos += ChunkHeaderSize + numBytes;
+    }
+
+    dataEnd = pos;
+}
+
+bool TelemetryPlayer::openCsv()
+{
+    file.seek(0);
+
+    index.clear();
+
+    int numLines = 0;
+    while (!file.atEnd()) {
+        const qint64 offset = file.pos();
+        const QByteArray line = file.readLine();
+
+        double time;
+        if (!csvTime(line, time))
+            continue; // header or garbage
+
+        if (numLines++ % CsvIndexInterval == 0) {
+            IndexEntry entry;
+            entry.time = time;
+            entry.offset = offset;
+            index += entry;
+        }
+
+        endTime = time;
+    }
+
+    if (index.isEmpty())
+        return false;
+
+    startTime = index.first().time;
+    dataEnd = file.size();
+
+    return true;
+}
+
+bool TelemetryPlayer::csvTime(const QByteArray &line, double &time) const
+{
+    const int pos = line.indexOf(',');
+    if (pos <= 0)
+        return false;
+
+    bool ok;
+    const double value = line.left(pos).trimmed().toDouble(&ok);
+    if (ok)
+        time = value * timeScale;
+
+    return ok;
+}
+
+void TelemetryPlayer::rewind(qint64 offset)
+{
+    file.seek(offset);
+    stream.resetStatus();
+
+    chunkFramesLeft = 0;
+    hasNext = false;
+}
+
+bool TelemetryPlayer::readFrame(QByteArray &frame, double &time)
+{
+    if (fileFormat == Csv) {
+        while (file.pos() < dataEnd) {
+            frame = file.readLine();
+            if (csvTime(frame, time))
+                return true;
+        }
+
+        return false;
+    }
+
+    while (chunkFramesLeft == 0) {
+        if (file.pos() >= dataEnd)
+            return false;
+
+        quint32 tag, numFrames, numBytes;
+        qint64 start;
+        stream >> tag >> start >> numFrames >> numBytes;
+
+        if (stream.status() != QDataStream::Ok || tag != TelemetryRecorder::ChunkTag)
+            return false;
+
+        chunkStart = start * 1.0e-6;
+        chunkFramesLeft = numFrames;
+    }
+
+    quint32 offset, length;
+    stream >> offset >> length;
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    frame.resize(length);
+    if (stream.readRawData(frame.data(), length) != int(length))
+        return false;
+
+    chunkFramesLeft--;
+    time = chunkStart + offset * 1.0e-6;
+
+    return true;
+}
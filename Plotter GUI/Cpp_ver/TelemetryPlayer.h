@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QObject>
+#include <QFile>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <QList>
+#include <QByteArray>
+
+/*
+   Replays recordings of TelemetryRecorder or CSV files
+   ( like DATA/payload_test.csv ) frame by frame
+
+   The frames are delivered with framesReady(), what can be connected to
+   the same slot as the frames from the serial port. Seeking is done by
+   a binary search in a sparse time index - read from the recording
+   or built, when opening a CSV file - followed by a short linear
+   scan inside of the chunk.
+ */
+class TelemetryPlayer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format
+    {
+        NoFormat,
+        Recording,
+        Csv
+    };
+
+    explicit TelemetryPlayer(QObject *parent = nullptr);
+    ~TelemetryPlayer();
+
+    bool open(const QString &fileName);
+    void close();
+
+    bool isOpen() const;
+    Format format() const;
+
+    // seconds per unit of the first column of a CSV file
+    void setCsvTimeScale(double scale);
+    double csvTimeScale() const;
+
+    double duration() const;
+    double position() const;
+
+    double speed() const;
+    bool isPlaying() const;
+
+public Q_SLOTS:
+    void play();
+    void pause();
+    void setSpeed(double speed);
+    void seek(double position);
+
+Q_SIGNALS:
+    void framesReady(const QList<QByteArray> &frames);
+    void positionChanged(double position);
+    void finished();
+
+private Q_SLOTS:
+    void tick();
+
+private:
+    bool openRecording();
+    bool openCsv();
+    bool readIndex();
+    void rebuildIndex();
+
+    bool readFrame(QByteArray &frame, double &time);
+    bool csvTime(const QByteArray &line, double &time) const;
+    void rewind(qint64 offset);
+
+    struct IndexEntry
+    {
+        double time;
+        qint64 offset;
+    };
+
+    QFile file;
+    QDataStream stream;
+    Format fileFormat;
+
+    QVector<IndexEntry> index;
+    qint64 dataEnd;
+    double startTime;
+    double endTime;
+    double timeScale;
+
+    // position inside of the current chunk of a recording
+    double chunkStart;
+    quint32 chunkFramesLeft;
+
+    // the next frame, that has not been delivered yet
+    QByteArray nextFrame;
+    double nextTime;
+    bool hasNext;
+
+    double playbackSpeed;
+    double current;
+
+    QTimer timer;
+    QElapsedTimer clock;
+};
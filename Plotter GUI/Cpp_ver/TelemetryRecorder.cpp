@@ -0,0 +1,107 @@
+#include "TelemetryRecorder.h"
+
+#include <QDataStream>
+
+// a chunk is written, when one of the limits is reached. They also
+// define the granularity of the index and by that the seek costs
+static const quint32 MaxChunkFrames = 512;
+static const qint64 MaxChunkDuration = 1000000; // us
+
+TelemetryRecorder::TelemetryRecorder()
+    : chunkStart(0)
+    , chunkFrames(0)
+{
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    close();
+}
+
+bool TelemetryRecorder::open(const QString &fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream << quint32(FileTag) << Version;
+
+    chunk.clear();
+    chunkFrames = 0;
+    index.clear();
+
+    timer.start();
+
+    return true;
+}
+
+void TelemetryRecorder::close()
+{
+    if (!file.isOpen())
+        return;
+
+    flushChunk();
+
+    const qint64 indexOffset = file.pos();
+
+    QDataStream stream(&file);
+    stream << quint32(IndexTag) << quint32(index.size());
+    for (const IndexEntry &entry : index)
+        stream << entry.time << entry.offset;
+
+    stream << indexOffset << quint32(TrailerTag);
+
+    file.close();
+}
+
+bool TelemetryRecorder::isRecording() const
+{
+    return file.isOpen();
+}
+
+QString TelemetryRecorder::fileName() const
+{
+    return file.fileName();
+}
+
+void TelemetryRecorder::record(const QByteArray &frame)
+{
+    if (!file.isOpen())
+        return;
+
+    const qint64 time = timer.nsecsElapsed() / 1000;
+
+    if (chunkFrames > 0 && time - chunkStart >= MaxChunkDuration)
+        flushChunk();
+
+    if (chunkFrames == 0)
+        chunkStart = time;
+
+    QDataStream stream(&chunk, QIODevice::Append);
+    stream << quint32(time - chunkStart) << quint32(frame.size());
+    stream.writeRawData(frame.constData(), frame.size());
+
+    if (++chunkFrames >= MaxChunkFrames)
+        flushChunk();
+}
+
+void TelemetryRecorder::flushChunk()
+{
+    if (chunkFrames == 0)
+        return;
+
+    IndexEntry entry;
+    entry.time = chunkStart;
+    entry.offset = file.pos();
+    index += entry;
+
+    QDataStream stream(&file);
+    stream << quint32(ChunkTag) << chunkStart << chunkFrames << quint32(chunk.size());
+    stream.writeRawData(chunk.constData(), chunk.size());
+
+    chunk.clear();
+    chunkFrames = 0;
+}
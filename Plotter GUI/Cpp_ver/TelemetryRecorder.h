@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QFile>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QVector>
+
+/*
+   Records raw telemetry frames, as they arrive from the serial port
+
+   The file consists of chunks of frames, each frame stamped with its
+   arrival time. When the recording is closed a sparse index ( start time
+   and file offset of each chunk ) is appended, that allows seeking
+   without scanning the file. A recording without index ( f.e. after
+   a crash ) can still be read, see TelemetryPlayer.
+
+   header:  'VIPR' version
+   chunk:   'CHNK' startTime(us) numFrames numBytes
+            { timeOffset(us) length bytes } * numFrames
+   index:   'INDX' numChunks { startTime(us) fileOffset } * numChunks
+   trailer: indexOffset 'VEND'
+ */
+class TelemetryRecorder
+{
+public:
+    enum Tag
+    {
+        FileTag = 0x56495052,    // VIPR
+        ChunkTag = 0x43484e4b,   // CHNK
+        IndexTag = 0x494e4458,   // INDX
+        TrailerTag = 0x56454e44  // VEND
+    };
+
+    static const quint32 Version = 1;
+
+    // size of the trailer: qint64 + quint32
+    static const int TrailerSize = 12;
+
+    TelemetryRecorder();
+    ~TelemetryRecorder();
+
+    bool open(const QString &fileName);
+    void close();
+
+    bool isRecording() const;
+    QString fileName() const;
+
+    void record(const QByteArray &frame);
+
+private:
+    void flushChunk();
+
+    struct IndexEntry
+    {
+        qint64 time;
+        qint64 offset;
+    };
+
+    QFile file;
+    QElapsedTimer timer;
+
+    QByteArray chunk;
+    qint64 chunkStart;
+    quint32 chunkFrames;
+
+    QVector<IndexEntry> index;
+};
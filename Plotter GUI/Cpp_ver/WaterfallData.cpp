@@ -0,0 +1,140 @@
+#include "WaterfallData.h"
+
+#include <QRectF>
+
+#include <algorithm>
+#include <limits>
+
+WaterfallData::WaterfallData(int numRows)
+    : rows(qMax(numRows, 1))
+    , bins(0)
+    , head(0)
+    , filled(0)
+    , binWidth(1.0)
+    , rowInterval(1.0)
+    , valueRange(-100.0, 0.0)
+{
+    // rows, that have not been filled yet, are reported as NaN
+    setAttribute(QwtRasterData::WithoutGaps, false);
+}
+
+void WaterfallData::setNumRows(int numRows)
+{
+    numRows = qMax(numRows, 1);
+    if (numRows != rows) {
+        rows = numRows;
+        clear();
+    }
+}
+
+int WaterfallData::numRows() const
+{
+    return rows;
+}
+
+int WaterfallData::numBins() const
+{
+    return bins;
+}
+
+void WaterfallData::setValueRange(const QwtInterval &range)
+{
+    valueRange = range;
+}
+
+void WaterfallData::clear()
+{
+    values.fill(0.0, rows * bins);
+    head = 0;
+    filled = 0;
+}
+
+void WaterfallData::appendRow(const QVector<double> &row,
+    double width, double duration)
+{
+    if (row.isEmpty())
+        return;
+
+    if (row.size() != bins) {
+        // a different FFT size invalidates the history
+        bins = row.size();
+        clear();
+    }
+
+    binWidth = width;
+    rowInterval = duration;
+
+    // overwriting the oldest row, the others stay where they are
+    std::copy(row.constBegin(), row.constEnd(), values.begin() + head * bins);
+
+    head = (head + 1) % rows;
+    if (filled < rows)
+        filled++;
+}
+
+QwtInterval WaterfallData::interval(Qt::Axis axis) const
+{
+    switch (axis) {
+    case Qt::XAxis:
+        return QwtInterval(0.0, bins * binWidth);
+    case Qt::YAxis:
+        return QwtInterval(-rows * rowInterval, 0.0);
+    case Qt::ZAxis:
+        return valueRange;
+    }
+
+    return QwtInterval();
+}
+
+QRectF WaterfallData::pixelHint(const QRectF &area) const
+{
+    Q_UNUSED(area)
+
+    // one cell of the matrix, aligned to the frequency 0
+    // and to the most recent row
+
+    if (bins <= 0)
+        return QRectF();
+
+    return QRectF(0.0, -rows * rowInterval, binWidth, rowInterval);
+}
+
+double WaterfallData::value(double x, double y) const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    if (x < 0.0 || y > 0.0)
+        return nan;
+
+    const int bin = static_cast<int>(x / binWidth);
+    const int age = static_cast<int>(-y / rowInterval);
+
+    if (bin >= bins || age >= filled)
+        return nan;
+
+    const int row = (head - 1 - age + rows) % rows;
+    return values[row * bins + bin];
+}
+
+void WaterfallData::rowValues(const double *x, double y,
+    double *rowData, int count) const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // the row is the same for all x, only the bin has to be looked up
+
+    const int age = static_cast<int>(-y / rowInterval);
+
+    if (y > 0.0 || age >= filled || bins <= 0) {
+        std::fill(rowData, rowData + count, nan);
+        return;
+    }
+
+    const int row = (head - 1 - age + rows) % rows;
+    const double *cells = values.constData() + row * bins;
+
+    for (int i = 0; i < count; i++) {
+        const int bin = static_cast<int>(x[i] / binWidth);
+        rowData[i] = (x[i] < 0.0 || bin >= bins) ? nan : cells[bin];
+    }
+}
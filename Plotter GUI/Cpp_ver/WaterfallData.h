@@ -0,0 +1,49 @@
+#pragma once
+
+#include <qwt_raster_data.h>
+#include <qwt_interval.h>
+
+#include <QVector>
+
+/*
+   Raster data of a scrolling waterfall display
+
+   The rows are stored in a ring buffer: appending a spectrum overwrites
+   the oldest row and moves the head, without touching the other rows.
+   x is the frequency, y the age of a row in seconds ( 0 is the most
+   recent spectrum, older rows have negative values ).
+ */
+class WaterfallData : public QwtRasterData
+{
+public:
+    WaterfallData(int numRows = 200);
+
+    void setNumRows(int numRows);
+    int numRows() const;
+
+    int numBins() const;
+
+    void setValueRange(const QwtInterval &range);
+
+    void appendRow(const QVector<double> &row, double width, double duration);
+    void clear();
+
+    virtual QwtInterval interval(Qt::Axis axis) const QWT_OVERRIDE;
+    virtual QRectF pixelHint(const QRectF &area) const QWT_OVERRIDE;
+    virtual double value(double x, double y) const QWT_OVERRIDE;
+    virtual void rowValues(const double *x, double y,
+        double *rowData, int count) const QWT_OVERRIDE;
+
+private:
+    QVector<double> values;
+
+    int rows;
+    int bins;
+    int head;
+    int filled;
+
+    double binWidth;
+    double rowInterval;
+
+    QwtInterval valueRange;
+};
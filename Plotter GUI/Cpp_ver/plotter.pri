@@ -0,0 +1,30 @@
+######################################################################
+# Common settings for the ground station tools: builds against the
+# Qwt sources shipped in qwt-6.2.0 ( qmake && make inside qwt-6.2.0 first )
+######################################################################
+
+QWT_ROOT = $${PWD}/qwt-6.2.0
+include( $${QWT_ROOT}/qwtconfig.pri )
+include( $${QWT_ROOT}/qwtbuild.pri )
+include( $${QWT_ROOT}/qwtfunctions.pri )
+
+TEMPLATE     = app
+
+INCLUDEPATH += $${QWT_ROOT}/src
+DEPENDPATH  += $${QWT_ROOT}/src
+
+INCLUDEPATH += $${QWT_ROOT}/classincludes
+DEPENDPATH  += $${QWT_ROOT}/classincludes
+
+INCLUDEPATH += $${PWD}
+DEPENDPATH  += $${PWD}
+
+QT += widgets
+QT += concurrent
+
+QMAKE_RPATHDIR *= $${QWT_ROOT}/lib
+qwtAddLibrary($${QWT_ROOT}/lib, qwt)
+
+contains(QWT_CONFIG, QwtDll) {
+    DEFINES    += QT_DLL QWT_DLL
+}
@@ -0,0 +1,30 @@
+######################################################################
+# Serial telemetry plotter
+######################################################################
+
+include( $${PWD}/plotter.pri )
+
+TARGET   = plotter
+
+QT += serialport
+
+HEADERS = \
+    SpectrumAnalyzer.h \
+    WaterfallData.h \
+    TelemetryRecorder.h \
+    TelemetryPlayer.h \
+    CsvTable.h \
+    EnvelopeData.h \
+    EnvelopeCurve.h \
+    SerialPlotter.h
+
+SOURCES = \
+    SpectrumAnalyzer.cpp \
+    WaterfallData.cpp \
+    TelemetryRecorder.cpp \
+    TelemetryPlayer.cpp \
+    CsvTable.cpp \
+    EnvelopeData.cpp \
+    EnvelopeCurve.cpp \
+    SerialPlotter.cpp \
+    plotter.cpp
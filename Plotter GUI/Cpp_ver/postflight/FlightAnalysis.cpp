@@ -0,0 +1,216 @@
+#include "FlightAnalysis.h"
+#include "CsvTable.h"
+#include "SpectrumAnalyzer.h"
+
+#include <QtConcurrentMap>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+// half cycles smaller than this fraction of the peak are noise
+static const double DecrementThreshold = 0.1;
+
+static double dominantFrequency(const QVector<double> &values, double rate)
+{
+    // the largest power of 2 fitting into the window
+
+    int size = 16;
+    while (2 * size <= values.size())
+        size *= 2;
+
+    if (values.size() < size)
+        return qQNaN();
+
+    SpectrumAnalyzer analyzer;
+    analyzer.setFftSize(size);
+
+    const int offset = (values.size() - size) / 2;
+    const QVector<double> amplitudes = analyzer.spectrum(values.constData() + offset);
+
+    int peak = 1;
+    for (int k = 2; k < amplitudes.size(); k++) {
+        if (amplitudes[k] > amplitudes[peak])
+            peak = k;
+    }
+
+    // parabolic interpolation between the neighbouring bins
+    double delta = 0.0;
+    if (peak + 1 < amplitudes.size()) {
+        const double a = amplitudes[peak - 1];
+        const double b = amplitudes[peak];
+        const double c = amplitudes[peak + 1];
+
+        const double denominator = a - 2.0 * b + c;
+        if (denominator != 0.0)
+            delta = 0.5 * (a - c) / denominator;
+    }
+
+    return (peak + delta) * rate / size;
+}
+
+static double dampingRatio(const QVector<double> &values, double mean, double peak)
+{
+    // maxima of the positive half cycles, using a hysteresis
+    // around the mean to ignore the noise at the zero crossings
+
+    const double threshold = DecrementThreshold * peak;
+
+    QVector<double> maxima;
+
+    bool isPositive = false;
+    for (double value : values) {
+        const double x = value - mean;
+
+        if (isPositive) {
+            if (x < -threshold)
+                isPositive = false;
+            else
+                maxima.last() = qMax(maxima.last(), x);
+        } else if (x > threshold) {
+            isPositive = true;
+            maxima += x;
+        }
+    }
+
+    // the decay starts at the largest oscillation
+    const int start = std::max_element(maxima.constBegin(), maxima.constEnd()) - maxima.constBegin();
+
+    const int numPeaks = maxima.size() - start;
+    if (numPeaks < 3)
+        return qQNaN();
+
+    // least squares fit of ln( peak ) over the cycle number,
+    // the slope is the negative logarithmic decrement
+
+    double sumK = 0.0, sumL = 0.0, sumKK = 0.0, sumKL = 0.0;
+    for (int k = 0; k < numPeaks; k++) {
+        const double l = std::log(maxima[start + k]);
+
+        sumK += k;
+        sumL += l;
+        sumKK += k * k;
+        sumKL += k * l;
+    }
+
+    const double slope = (numPeaks * sumKL - sumK * sumL) / (numPeaks * sumKK - sumK * sumK);
+    const double decrement = -slope;
+
+    return decrement / std::sqrt(4.0 * M_PI * M_PI + decrement * decrement);
+}
+
+FlightAnalysis::FlightAnalysis(const CsvTable &log, int timeColumn, double timeScale)
+    : table(log)
+    , timeValues(log.column(timeColumn))
+{
+    for (double &t : timeValues)
+        t *= timeScale;
+}
+
+const QVector<double> &FlightAnalysis::times() const
+{
+    return timeValues;
+}
+
+QVector<WindowStatistics> FlightAnalysis::analyze(const QVector<Window> &windows) const
+{
+    return QtConcurrent::blockingMapped<QVector<WindowStatistics>>(windows,
+        [this](const Window &window) { return analyzeWindow(window); });
+}
+
+WindowStatistics FlightAnalysis::analyzeWindow(const Window &window) const
+{
+    WindowStatistics stats;
+    stats.channel = table.columnName(window.column);
+    stats.label = window.label;
+    stats.from = window.from;
+    stats.to = window.to;
+    stats.numSamples = 0;
+    stats.mean = stats.rms = stats.peak = qQNaN();
+    stats.frequency = stats.damping = qQNaN();
+
+    // the log is ordered by time
+
+    const int from = std::lower_bound(timeValues.constBegin(),
+        timeValues.constEnd(), window.from) - timeValues.constBegin();
+
+    const int to = std::upper_bound(timeValues.constBegin(),
+        timeValues.constEnd(), window.to) - timeValues.constBegin();
+
+    const QVector<double> &column = table.column(window.column);
+
+    QVector<double> values;
+    values.reserve(qMax(to - from, 0));
+
+    for (int i = from; i < to; i++) {
+        if (!qIsNaN(column[i]))
+            values += column[i];
+    }
+
+    stats.numSamples = values.size();
+    if (values.size() < 2)
+        return stats;
+
+    double sum = 0.0;
+    for (double value : values)
+        sum += value;
+
+    stats.mean = sum / values.size();
+
+    double sumSquares = 0.0;
+    double peak = 0.0;
+
+    for (double value : values) {
+        const double d = value - stats.mean;
+
+        sumSquares += d * d;
+        peak = qMax(peak, qAbs(d));
+    }
+
+    stats.rms = std::sqrt(sumSquares / values.size());
+    stats.peak = peak;
+
+    // the spectrum and the decrement need equidistant samples:
+    // gaps are interpolated instead of being dropped
+
+    int first = from;
+    while (qIsNaN(column[first]))
+        first++;
+
+    int last = to - 1;
+    while (qIsNaN(column[last]))
+        last--;
+
+    QVector<double> series;
+    series.reserve(last - first + 1);
+
+    for (int i = first; i <= last; i++) {
+        if (!qIsNaN(column[i])) {
+            series += column[i];
+            continue;
+        }
+
+        int next = i + 1;
+        while (qIsNaN(column[next]))
+            next++;
+
+        const double y1 = column[i - 1];
+        const double y2 = column[next];
+
+        for (int j = i; j < next; j++)
+            series += y1 + (y2 - y1) * (j - i + 1) / (next - i + 1);
+
+        i = next - 1;
+    }
+
+    const double duration = timeValues[last] - timeValues[first];
+    if (duration > 0.0) {
+        const double rate = (last - first) / duration;
+        stats.frequency = dominantFrequency(series, rate);
+    }
+
+    if (peak > 0.0)
+        stats.damping = dampingRatio(series, stats.mean, peak);
+
+    return stats;
+}
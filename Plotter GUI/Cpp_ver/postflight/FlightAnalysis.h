@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+class CsvTable;
+
+// statistics of one channel inside a time window
+struct WindowStatistics
+{
+    QString channel;
+    QString label;
+
+    double from;
+    double to;
+    int numSamples;
+
+    double mean;
+    double rms;       // around the mean
+    double peak;      // largest deviation from the mean
+    double frequency; // of the largest spectral peak
+    double damping;   // ratio from the logarithmic decrement, NaN if unknown
+};
+
+/*
+   Per window statistics of the channels of a flight log
+
+   The windows are independent from each other and are
+   analyzed concurrently.
+ */
+class FlightAnalysis
+{
+public:
+    struct Window
+    {
+        int column;
+        QString label;
+        double from;
+        double to;
+    };
+
+    FlightAnalysis(const CsvTable &log, int timeColumn, double timeScale);
+
+    const QVector<double> &times() const;
+
+    QVector<WindowStatistics> analyze(const QVector<Window> &windows) const;
+
+private:
+    WindowStatistics analyzeWindow(const Window &window) const;
+
+    const CsvTable &table;
+    QVector<double> timeValues;
+};
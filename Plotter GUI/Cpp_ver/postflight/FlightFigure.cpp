@@ -0,0 +1,136 @@
+#include "FlightFigure.h"
+#include "EnvelopeCurve.h"
+
+#include <qwt_plot.h>
+#include <qwt_plot_renderer.h>
+#include <qwt_text.h>
+
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QSvgGenerator>
+
+// default colors of Matlab
+static const QColor ControlColor(0, 114, 189);
+static const QColor ExperimentalColor(Qt::red);
+
+static void setBoldAxisTitle(QwtPlot *plot, const QString &text)
+{
+    QwtText title(text);
+
+    QFont font = title.font();
+    font.setBold(true);
+    title.setFont(font);
+
+    plot->setAxisTitle(QwtAxis::YLeft, title);
+}
+
+FlightFigure::FlightFigure(const QVector<double> &times,
+    const QVector<double> &control, const QVector<double> &experimental,
+    const QwtInterval &before, const QwtInterval &after)
+{
+    const QwtInterval flight(times.isEmpty() ? 0.0 : times.first(),
+        times.isEmpty() ? 1.0 : times.last());
+
+    // the order of the tiles: 2 wide ones, then a 2x2 grid
+
+    addPlot("Control Patch Data", times, control, ControlColor, flight);
+    addPlot("Experimental Patch Data", times, experimental, ExperimentalColor, flight);
+
+    QwtPlot *plot = addPlot("Response Before State Change",
+        times, control, ControlColor, before);
+    setBoldAxisTitle(plot, "CONTROL");
+
+    addPlot("Response After State Change", times, control, ControlColor, after);
+
+    plot = addPlot(QString(), times, experimental, ExperimentalColor, before);
+    setBoldAxisTitle(plot, "EXPERIMENTAL");
+
+    addPlot(QString(), times, experimental, ExperimentalColor, after);
+
+    setValueRange(QwtInterval(0.0, 3.0));
+}
+
+FlightFigure::~FlightFigure()
+{
+    qDeleteAll(plots);
+}
+
+QwtPlot *FlightFigure::addPlot(const QString &title,
+    const QVector<double> &times, const QVector<double> &values,
+    const QColor &color, const QwtInterval &interval)
+{
+    QwtPlot *plot = new QwtPlot(title);
+    plot->setAutoReplot(false);
+    plot->setCanvasBackground(Qt::white);
+    plot->setAxisScale(QwtAxis::XBottom, interval.minValue(), interval.maxValue());
+
+    EnvelopeCurve *curve = new EnvelopeCurve();
+    curve->setPen(color);
+    curve->setEnvelopeSamples(times, values);
+    curve->attach(plot);
+
+    plots += plot;
+    return plot;
+}
+
+void FlightFigure::setValueRange(const QwtInterval &range)
+{
+    for (QwtPlot *plot : plots)
+        plot->setAxisScale(QwtAxis::YLeft, range.minValue(), range.maxValue());
+}
+
+bool FlightFigure::save(const QString &fileName, const QSize &size) const
+{
+    const QString suffix = QFileInfo(fileName).suffix().toLower();
+
+    if (suffix == "svg") {
+        QSvgGenerator generator;
+        generator.setFileName(fileName);
+        generator.setSize(size);
+        generator.setViewBox(QRect(QPoint(0, 0), size));
+        generator.setTitle("Integration Test");
+
+        QPainter painter(&generator);
+        render(&painter, size);
+
+        return painter.end();
+    }
+
+    QImage image(size, QImage::Format_ARGB32);
+    image.fill(Qt::white);
+
+    QPainter painter(&image);
+    render(&painter, size);
+    painter.end();
+
+    return image.save(fileName);
+}
+
+void FlightFigure::render(QPainter *painter, const QSize &size) const
+{
+    const double width = size.width();
+    const double height = size.height() / 4.0;
+
+    QwtPlotRenderer renderer;
+
+    for (int i = 0; i < plots.size(); i++) {
+        QRectF rect;
+        if (i < 2) {
+            rect.setRect(0.0, i * height, width, height);
+        } else {
+            const int tile = i - 2;
+            rect.setRect((tile % 2) * 0.5 * width,
+                (2 + tile / 2) * height, 0.5 * width, height);
+        }
+
+        // the plots are never shown, but the renderer
+        // needs their geometry and the scale divisions
+
+        QwtPlot *plot = plots[i];
+        plot->resize(rect.size().toSize());
+        plot->updateAxes();
+
+        renderer.render(plot, painter, rect);
+    }
+}
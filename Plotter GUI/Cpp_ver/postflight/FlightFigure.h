@@ -0,0 +1,40 @@
+#pragma once
+
+#include <qwt_interval.h>
+
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+class QwtPlot;
+class QPainter;
+
+/*
+   The figure of DATA/Integration_Test.m: control and experimental
+   patch over the complete flight, followed by both of them before
+   and after the state change.
+ */
+class FlightFigure
+{
+public:
+    FlightFigure(const QVector<double> &times,
+        const QVector<double> &control, const QVector<double> &experimental,
+        const QwtInterval &before, const QwtInterval &after);
+
+    ~FlightFigure();
+
+    void setValueRange(const QwtInterval &range);
+
+    // the format is taken from the suffix: svg or any image format
+    bool save(const QString &fileName, const QSize &size) const;
+
+private:
+    QwtPlot *addPlot(const QString &title,
+        const QVector<double> &times, const QVector<double> &values,
+        const QColor &color, const QwtInterval &interval);
+
+    void render(QPainter *painter, const QSize &size) const;
+
+    QList<QwtPlot *> plots;
+};
@@ -0,0 +1,182 @@
+#include "CsvTable.h"
+#include "FlightAnalysis.h"
+#include "FlightFigure.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+/*
+   postflight [options] log.csv
+
+   Statistics of the MFC channels for the windows before/after the state
+   change and for consecutive windows over the complete flight, written
+   as CSV. The figure of DATA/Integration_Test.m is rendered to PNG/SVG.
+   No display is needed: the offscreen platform is used by default.
+ */
+
+static bool parseInterval(const QString &text, QwtInterval &interval)
+{
+    const QStringList values = text.split(':');
+    if (values.size() != 2)
+        return false;
+
+    bool ok1, ok2;
+    interval.setInterval(values[0].toDouble(&ok1), values[1].toDouble(&ok2));
+
+    return ok1 && ok2 && interval.isValid();
+}
+
+static QString numberText(double value)
+{
+    return qIsNaN(value) ? QString() : QString::number(value, 'g', 8);
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("postflight");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Post-flight analysis of VIPER-E logs");
+    parser.addHelpOption();
+    parser.addPositionalArgument("log", "CSV log of the flight");
+
+    const QCommandLineOption figureOption({ "f", "figure" },
+        "Figure to render ( .png, .svg, ... ).", "file");
+    const QCommandLineOption statsOption({ "s", "stats" },
+        "CSV file for the statistics, default is stdout.", "file");
+    const QCommandLineOption sizeOption("size",
+        "Size of the figure in pixels.", "WxH", "1200x1000");
+    const QCommandLineOption timeScaleOption("time-scale",
+        "Seconds per unit of the time column.", "scale", "1e-6");
+    const QCommandLineOption windowOption({ "w", "window" },
+        "Length of the consecutive windows in seconds, 0 to disable.", "seconds", "1");
+    const QCommandLineOption beforeOption("before",
+        "Window before the state change.", "from:to", "0.75:1");
+    const QCommandLineOption afterOption("after",
+        "Window after the state change.", "from:to", "14.3:14.55");
+    const QCommandLineOption controlOption("control",
+        "Column of the control patch.", "name", "MFC_C");
+    const QCommandLineOption experimentalOption("experimental",
+        "Column of the experimental patch.", "name", "MFC_E");
+
+    parser.addOptions({ figureOption, statsOption, sizeOption, timeScaleOption,
+        windowOption, beforeOption, afterOption, controlOption, experimentalOption });
+
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1)
+        parser.showHelp(1);
+
+    QwtInterval before, after;
+    if (!parseInterval(parser.value(beforeOption), before)
+        || !parseInterval(parser.value(afterOption), after)) {
+        err << "Invalid window, expected from:to\n";
+        return 1;
+    }
+
+    const QStringList sizeValues = parser.value(sizeOption).split('x');
+    const QSize figureSize = (sizeValues.size() == 2)
+        ? QSize(sizeValues[0].toInt(), sizeValues[1].toInt()) : QSize();
+
+    if (figureSize.isEmpty()) {
+        err << "Invalid size, expected WxH\n";
+        return 1;
+    }
+
+    const double timeScale = parser.value(timeScaleOption).toDouble();
+    const double windowLength = parser.value(windowOption).toDouble();
+
+    CsvTable table;
+    if (!table.load(args[0])) {
+        err << args[0] << ": " << table.errorString() << "\n";
+        return 1;
+    }
+
+    const int timeColumn = table.timeColumn();
+    const int controlColumn = table.columnIndex(parser.value(controlOption));
+    const int experimentalColumn = table.columnIndex(parser.value(experimentalOption));
+
+    if (timeColumn < 0 || controlColumn < 0 || experimentalColumn < 0) {
+        err << args[0] << ": missing time, control or experimental column\n";
+        return 1;
+    }
+
+    FlightAnalysis analysis(table, timeColumn, timeScale > 0.0 ? timeScale : 1.0e-6);
+
+    const QVector<double> &times = analysis.times();
+    if (times.isEmpty()) {
+        err << args[0] << ": no samples\n";
+        return 1;
+    }
+
+    QVector<FlightAnalysis::Window> windows;
+
+    auto addWindow = [&windows](int column, const QString &label, double from, double to) {
+        FlightAnalysis::Window window;
+        window.column = column;
+        window.label = label;
+        window.from = from;
+        window.to = to;
+
+        windows += window;
+    };
+
+    for (int column : { controlColumn, experimentalColumn }) {
+        addWindow(column, "before", before.minValue(), before.maxValue());
+        addWindow(column, "after", after.minValue(), after.maxValue());
+
+        if (windowLength > 0.0) {
+            int n = 0;
+            for (double t = times.first(); t < times.last(); t += windowLength)
+                addWindow(column, QString("w%1").arg(n++), t, t + windowLength);
+        }
+    }
+
+    const QVector<WindowStatistics> statistics = analysis.analyze(windows);
+
+    QFile statsFile;
+    if (parser.isSet(statsOption)) {
+        statsFile.setFileName(parser.value(statsOption));
+        if (!statsFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            err << statsFile.fileName() << ": " << statsFile.errorString() << "\n";
+            return 1;
+        }
+    } else {
+        statsFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+
+    QTextStream out(&statsFile);
+    out << "channel,window,from_s,to_s,samples,mean_V,rms_V,peak_V,frequency_Hz,damping\n";
+
+    for (const WindowStatistics &stats : statistics) {
+        out << stats.channel << ',' << stats.label << ','
+            << numberText(stats.from) << ',' << numberText(stats.to) << ','
+            << stats.numSamples << ',' << numberText(stats.mean) << ','
+            << numberText(stats.rms) << ',' << numberText(stats.peak) << ','
+            << numberText(stats.frequency) << ',' << numberText(stats.damping) << '\n';
+    }
+
+    out.flush();
+
+    if (parser.isSet(figureOption)) {
+        const FlightFigure figure(times, table.column(controlColumn),
+            table.column(experimentalColumn), before, after);
+
+        const QString fileName = parser.value(figureOption);
+        if (!figure.save(fileName, figureSize)) {
+            err << fileName << ": rendering failed\n";
+            return 1;
+        }
+    }
+
+    return 0;
+}
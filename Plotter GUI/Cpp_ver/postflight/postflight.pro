@@ -0,0 +1,29 @@
+######################################################################
+# Headless post-flight analysis of VIPER-E logs
+######################################################################
+
+include( $${PWD}/../plotter.pri )
+
+TARGET   = postflight
+
+CONFIG  += console
+CONFIG  -= app_bundle
+
+QT      += svg
+
+HEADERS = \
+    ../CsvTable.h \
+    ../EnvelopeData.h \
+    ../EnvelopeCurve.h \
+    ../SpectrumAnalyzer.h \
+    FlightAnalysis.h \
+    FlightFigure.h
+
+SOURCES = \
+    ../CsvTable.cpp \
+    ../EnvelopeData.cpp \
+    ../EnvelopeCurve.cpp \
+    ../SpectrumAnalyzer.cpp \
+    FlightAnalysis.cpp \
+    FlightFigure.cpp \
+    main.cpp
@@ -33,6 +33,7 @@ CLASSHEADERS = \
     QwtHueColorMap \
     QwtInterval \
     QwtIntervalSymbol \
+    QwtLineRasterizer \
     QwtLinearColorMap \
     QwtLinearScaleEngine \
     QwtLogScaleEngine \
@@ -165,7 +166,8 @@ contains(QWT_CONFIG, QwtOpenGL) {
         greaterThan(QT_MINOR_VERSION, 3) {
 
             CLASSHEADERS += \
-                QwtPlotOpenGLCanvas
+                QwtPlotOpenGLCanvas \
+                QwtPlotOpenGLCurve
         }
     }
 }
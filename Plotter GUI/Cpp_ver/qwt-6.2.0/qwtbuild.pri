@@ -173,6 +173,16 @@ linux {
     # QMAKE_CXXFLAGS   *= -Werror
 }
 
+contains(QWT_CONFIG, QwtAvx) {
+
+    msvc {
+        QMAKE_CXXFLAGS += /arch:AVX
+    }
+    else {
+        QMAKE_CXXFLAGS += -mavx
+    }
+}
+
 qtsystemincludes {
     
     # mark Qt directories as a system directories - usually to get rid
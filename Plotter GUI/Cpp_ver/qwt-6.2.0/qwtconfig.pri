@@ -108,6 +108,14 @@ QWT_CONFIG     += QwtSvg
 
 QWT_CONFIG     += QwtOpenGL
 
+######################################################################
+# Mapping points is done with SSE2 ( x86_64 ) or NEON ( aarch64 ).
+# If the library will run on CPUs supporting AVX only, enable the
+# line below to use AVX as well.
+######################################################################
+
+#QWT_CONFIG     += QwtAvx
+
 ######################################################################
 # If you want to build the Qwt designer plugin,
 # enable the line below.
@@ -14,8 +14,17 @@
 
 #include <qpolygon.h>
 #include <qrect.h>
+#include <qnumeric.h>
 
 #include <algorithm>
+#include <cstring>
+
+/*
+   Points are processed in chunks. When the bounding rectangle of a chunk
+   is completely inside - or completely outside of one of the edges - it
+   can be passed on without checking each point.
+ */
+static const int qwtClipChunkSize = 32;
 
 namespace QwtClip
 {
@@ -24,6 +33,20 @@ namespace QwtClip
     template< class Point, typename T > class RightEdge;
     template< class Point, typename T > class TopEdge;
     template< class Point, typename T > class BottomEdge;
+
+    template< class Point, typename T, class Edge, class Next > class Stage;
+    template< class Polygon > class Sink;
+}
+
+static inline bool qwtIsEqual( const QPoint& p1, const QPoint& p2 )
+{
+    return p1 == p2;
+}
+
+static inline bool qwtIsEqual( const QPointF& p1, const QPointF& p2 )
+{
+    // QPointF::operator==() is fuzzy
+    return ( p1.x() == p2.x() ) && ( p1.y() == p2.y() );
 }
 
 template< class Point, typename Value >
@@ -121,100 +144,575 @@ class QwtClip::BottomEdge
     const Value m_y2;
 };
 
+/*
+   One edge of the Sutherland-Hodgman algorithm, that passes its
+   output point by point to the next edge. Chaining the edges clips
+   against all of them in one pass without intermediate polygons.
+
+   The difference to running the edges one after the other is, that
+   the intersection with the closing line of a polygon is appended
+   at the end instead of being inserted at the beginning. The result
+   is the same polygon - only starting at a different point.
+ */
+template< class Point, typename Value, class Edge, class Next >
+class QwtClip::Stage
+{
+  public:
+    inline Stage( int index, const Edge& edge, bool closePolygon, Next& next ):
+        m_index( index ),
+        m_edge( edge ),
+        m_closePolygon( closePolygon ),
+        m_next( next ),
+        m_count( 0 ),
+        m_prevInside( false ),
+        m_firstInside( false )
+    {
+    }
+
+    inline void add( const Point& p )
+    {
+        const bool inside = m_edge.isInside( p );
+
+        if ( m_count++ == 0 )
+        {
+            m_first = p;
+            m_firstInside = inside;
+
+            if ( inside )
+                m_next.add( p );
+        }
+        else
+        {
+            if ( inside )
+            {
+                if ( !m_prevInside )
+                    m_next.add( m_edge.intersection( p, m_prev ) );
+
+                m_next.add( p );
+            }
+            else if ( m_prevInside )
+            {
+                m_next.add( m_edge.intersection( p, m_prev ) );
+            }
+        }
+
+        m_prev = p;
+        m_prevInside = inside;
+    }
+
+    /*
+        Points, that are - like the previous one - inside of all edges
+        before the rejecting stage and outside of the rejecting edge.
+     */
+    inline void addRun( const Point* points, int count, int rejectingStage )
+    {
+        m_count += count;
+        m_prev = points[count - 1];
+
+        if ( m_index == rejectingStage )
+        {
+            m_prevInside = false;
+        }
+        else
+        {
+            m_prevInside = true;
+            m_next.addRun( points, count, rejectingStage );
+        }
+    }
+
+    inline void flush()
+    {
+        if ( m_count == 1 )
+        {
+            // a single point is never clipped
+            if ( !m_firstInside )
+                m_next.add( m_first );
+        }
+        else if ( m_closePolygon && ( m_count > 1 ) )
+        {
+            if ( m_firstInside != m_prevInside )
+                m_next.add( m_edge.intersection( m_first, m_prev ) );
+        }
+
+        m_next.flush();
+    }
+
+  private:
+    const int m_index;
+    const Edge m_edge;
+    const bool m_closePolygon;
+    Next& m_next;
+
+    int m_count;
+
+    Point m_prev;
+    bool m_prevInside;
+
+    Point m_first;
+    bool m_firstInside;
+};
+
+/*
+   The end of the chain, collecting the clipped points. As long as
+   the clipped points are the leading points of the input nothing
+   is written.
+ */
+template< class Polygon >
+class QwtClip::Sink
+{
+    typedef typename Polygon::value_type Point;
+
+  public:
+    inline Sink( const Polygon& points, Polygon& clippedPoints ):
+        m_points( points.constData() ),
+        m_numPoints( points.size() ),
+        m_clippedPoints( clippedPoints ),
+        m_numIdentical( 0 ),
+        m_isIdentical( true )
+    {
+        m_clippedPoints.clear();
+    }
+
+    inline void add( const Point& p )
+    {
+        if ( m_isIdentical )
+        {
+            if ( m_numIdentical < m_numPoints
+                && qwtIsEqual( p, m_points[m_numIdentical] ) )
+            {
+                m_numIdentical++;
+                return;
+            }
+
+            detach();
+        }
+
+        m_clippedPoints += p;
+    }
+
+    inline void addRun( const Point* points, int count, int )
+    {
+        if ( m_isIdentical )
+        {
+            if ( points == m_points + m_numIdentical )
+            {
+                m_numIdentical += count;
+                return;
+            }
+
+            detach();
+        }
+
+        const int size = m_clippedPoints.size();
+        m_clippedPoints.resize( size + count );
+
+        std::memcpy( m_clippedPoints.data() + size, points, count * sizeof( Point ) );
+    }
+
+    inline void flush()
+    {
+        if ( m_isIdentical && m_numIdentical < m_numPoints )
+            detach();
+    }
+
+    inline bool isIdentical() const
+    {
+        return m_isIdentical;
+    }
+
+  private:
+    void detach()
+    {
+        m_isIdentical = false;
+
+        m_clippedPoints.reserve( qMin( 256, m_numPoints ) );
+        for ( int i = 0; i < m_numIdentical; i++ )
+            m_clippedPoints += m_points[i];
+    }
+
+    const Point* m_points;
+    const int m_numPoints;
+
+    Polygon& m_clippedPoints;
+
+    int m_numIdentical;
+    bool m_isIdentical;
+};
+
 using namespace QwtClip;
 
 template< class Polygon, class Rect, typename T >
 class QwtPolygonClipper
 {
     typedef typename Polygon::value_type Point;
+
   public:
     explicit QwtPolygonClipper( const Rect& clipRect ):
-        m_clipRect( clipRect )
+        m_x1( clipRect.x() ),
+        m_x2( clipRect.x() + clipRect.width() ),
+        m_y1( clipRect.y() ),
+        m_y2( clipRect.y() + clipRect.height() )
+    {
+    }
+
+    void clipPolygon( Polygon& points, bool closePolygon ) const
     {
+        Polygon clippedPoints;
+        if ( !clipPolygon( points, clippedPoints, closePolygon ) )
+            points = clippedPoints;
     }
 
-    void clipPolygon( Polygon& points1, bool closePolygon ) const
+    /*
+        Returns true, when all points are inside, what leaves
+        clippedPoints empty.
+     */
+    bool clipPolygon( const Polygon& points,
+        Polygon& clippedPoints, bool closePolygon ) const
     {
-#if 0
-        if ( m_clipRect.contains( points1.boundingRect() ) )
-            return polygon;
-#endif
+        typedef Sink< Polygon > Sink0;
+        typedef Stage< Point, T, BottomEdge< Point, T >, Sink0 > Stage3;
+        typedef Stage< Point, T, TopEdge< Point, T >, Stage3 > Stage2;
+        typedef Stage< Point, T, RightEdge< Point, T >, Stage2 > Stage1;
+        typedef Stage< Point, T, LeftEdge< Point, T >, Stage1 > Stage0;
+
+        Sink0 sink( points, clippedPoints );
+
+        Stage3 bottom( 3, BottomEdge< Point, T >( m_x1, m_x2, m_y1, m_y2 ),
+            closePolygon, sink );
+        Stage2 top( 2, TopEdge< Point, T >( m_x1, m_x2, m_y1, m_y2 ),
+            closePolygon, bottom );
+        Stage1 right( 1, RightEdge< Point, T >( m_x1, m_x2, m_y1, m_y2 ),
+            closePolygon, top );
+        Stage0 left( 0, LeftEdge< Point, T >( m_x1, m_x2, m_y1, m_y2 ),
+            closePolygon, right );
+
+        const int numPoints = points.size();
+        const Point* p = points.constData();
+
+        for ( int i = 0; i < numPoints; i += qwtClipChunkSize )
+        {
+            const int count = qMin( qwtClipChunkSize, numPoints - i );
 
-        Polygon points2;
-        points2.reserve( qMin( 256, points1.size() ) );
+            // the transition from the previous chunk
+            left.add( p[i] );
 
-        clipEdge< LeftEdge< Point, T > >( closePolygon, points1, points2 );
-        clipEdge< RightEdge< Point, T > >( closePolygon, points2, points1 );
-        clipEdge< TopEdge< Point, T > >( closePolygon, points1, points2 );
-        clipEdge< BottomEdge< Point, T > >( closePolygon, points2, points1 );
+            if ( count > 1 )
+            {
+                const int stage = rejectingStage( p + i, count );
+                if ( stage >= 0 )
+                {
+                    left.addRun( p + i + 1, count - 1, stage );
+                }
+                else
+                {
+                    for ( int j = i + 1; j < i + count; j++ )
+                        left.add( p[j] );
+                }
+            }
+        }
+
+        left.flush();
+
+        return sink.isIdentical();
     }
 
   private:
-    template< class Edge >
-    inline void clipEdge( bool closePolygon,
-        const Polygon& points, Polygon& clippedPoints ) const
+    /*
+        The index of the first edge, where all points are outside,
+        when being inside of all edges before. 4 means all points
+        are inside, -1 that the points need to be clipped one by one.
+     */
+    inline int rejectingStage( const Point* points, int count ) const
     {
-        clippedPoints.clear();
+        T minX = points[0].x();
+        T maxX = minX;
+        T minY = points[0].y();
+        T maxY = minY;
+
+        // catching NaNs, that would be lost in qMin/qMax
+        double sum = 0.0;
 
-        if ( points.size() < 2 )
+        for ( int i = 0; i < count; i++ )
         {
-            if ( points.size() == 1 )
-                clippedPoints += points[0];
+            const T x = points[i].x();
+            const T y = points[i].y();
 
-            return;
+            minX = qMin( minX, x );
+            maxX = qMax( maxX, x );
+            minY = qMin( minY, y );
+            maxY = qMax( maxY, y );
+
+            sum += double( x ) + double( y );
         }
 
-        const Edge edge( m_clipRect.x(), m_clipRect.x() + m_clipRect.width(),
-            m_clipRect.y(), m_clipRect.y() + m_clipRect.height() );
+        if ( qIsNaN( sum ) )
+            return -1;
+
+        if ( maxX < m_x1 )
+            return 0;
+
+        if ( minX < m_x1 )
+            return -1;
+
+        if ( minX > m_x2 )
+            return 1;
+
+        if ( maxX > m_x2 )
+            return -1;
+
+        if ( maxY < m_y1 )
+            return 2;
+
+        if ( minY < m_y1 )
+            return -1;
+
+        if ( minY > m_y2 )
+            return 3;
+
+        if ( maxY > m_y2 )
+            return -1;
+
+        return 4;
+    }
+
+    const T m_x1;
+    const T m_x2;
+    const T m_y1;
+    const T m_y2;
+};
+
+/*
+   Splits a polyline into the parts inside of the clip rectangle.
+   In opposite to Sutherland-Hodgman no points are inserted
+   along the edges of the rectangle.
+ */
+class QwtPolylineSplitter
+{
+  public:
+    explicit QwtPolylineSplitter( const QRectF& clipRect ):
+        m_x1( clipRect.left() ),
+        m_x2( clipRect.right() ),
+        m_y1( clipRect.top() ),
+        m_y2( clipRect.bottom() )
+    {
+    }
+
+    QVector< QPolygonF > split( const QPolygonF& polyline ) const
+    {
+        QVector< QPolygonF > parts;
+
+        const int numPoints = polyline.size();
+        const QPointF* p = polyline.constData();
 
-        if ( !closePolygon )
+        if ( numPoints < 2 )
         {
-            const Point& p1 = points.first();
+            if ( numPoints == 1 && outCode( p[0] ) == 0 )
+                parts += polyline;
 
-            if ( edge.isInside( p1 ) )
-                clippedPoints += p1;
+            return parts;
         }
-        else
+
+        QPolygonF part;
+        if ( outCode( p[0] ) == 0 )
+            part += p[0];
+
+        for ( int i = 1; i < numPoints; i += qwtClipChunkSize )
         {
-            const Point& p1 = points.first();
-            const Point& p2 = points.last();
+            const int count = qMin( qwtClipChunkSize, numPoints - i );
 
-            if ( edge.isInside( p1 ) )
-            {
-                if ( !edge.isInside( p2 ) )
-                    clippedPoints += edge.intersection( p1, p2 );
+            // the transition from the previous chunk
+            addLine( p[i - 1], p[i], part, parts );
 
-                clippedPoints += p1;
-            }
-            else if ( edge.isInside( p2 ) )
+            if ( count > 1 )
             {
-                clippedPoints += edge.intersection( p1, p2 );
+                double minX = p[i].x();
+                double maxX = minX;
+                double minY = p[i].y();
+                double maxY = minY;
+
+                double sum = 0.0;
+
+                for ( int j = i; j < i + count; j++ )
+                {
+                    minX = qMin( minX, p[j].x() );
+                    maxX = qMax( maxX, p[j].x() );
+                    minY = qMin( minY, p[j].y() );
+                    maxY = qMax( maxY, p[j].y() );
+
+                    sum += p[j].x() + p[j].y();
+                }
+
+                if ( qIsNaN( sum ) )
+                {
+                    for ( int j = i + 1; j < i + count; j++ )
+                        addLine( p[j - 1], p[j], part, parts );
+                }
+                else if ( maxX < m_x1 || minX > m_x2 || maxY < m_y1 || minY > m_y2 )
+                {
+                    // an excursion: nothing to do
+                }
+                else if ( minX >= m_x1 && maxX <= m_x2
+                    && minY >= m_y1 && maxY <= m_y2 )
+                {
+                    const int size = part.size();
+                    part.resize( size + count - 1 );
+
+                    std::memcpy( part.data() + size, p + i + 1,
+                        ( count - 1 ) * sizeof( QPointF ) );
+                }
+                else
+                {
+                    for ( int j = i + 1; j < i + count; j++ )
+                        addLine( p[j - 1], p[j], part, parts );
+                }
             }
         }
 
-        const uint nPoints = points.size();
-        const Point* p = points.constData();
+        closePart( part, parts );
+
+        return parts;
+    }
+
+  private:
+    enum
+    {
+        Left = 1,
+        Right = 2,
+        Top = 4,
+        Bottom = 8,
+
+        // NaN coordinates
+        Invalid = 16
+    };
+
+    inline int outCode( const QPointF& p ) const
+    {
+        int code = 0;
 
-        for ( uint i = 1; i < nPoints; i++ )
+        if ( p.x() >= m_x1 )
         {
-            const Point& p1 = p[i];
-            const Point& p2 = p[i - 1];
+            if ( p.x() > m_x2 )
+                code |= Right;
+        }
+        else if ( p.x() < m_x1 )
+        {
+            code |= Left;
+        }
+        else
+        {
+            return Invalid;
+        }
 
-            if ( edge.isInside( p1 ) )
-            {
-                if ( !edge.isInside( p2 ) )
-                    clippedPoints += edge.intersection( p1, p2 );
+        if ( p.y() >= m_y1 )
+        {
+            if ( p.y() > m_y2 )
+                code |= Bottom;
+        }
+        else if ( p.y() < m_y1 )
+        {
+            code |= Top;
+        }
+        else
+        {
+            return Invalid;
+        }
+
+        return code;
+    }
+
+    // Liang-Barsky
+    static inline bool clipT( double denom, double num, double& t1, double& t2 )
+    {
+        if ( denom == 0.0 )
+            return num >= 0.0;
+
+        const double t = num / denom;
+
+        if ( denom < 0.0 )
+        {
+            if ( t > t2 )
+                return false;
+
+            if ( t > t1 )
+                t1 = t;
+        }
+        else
+        {
+            if ( t < t1 )
+                return false;
+
+            if ( t < t2 )
+                t2 = t;
+        }
+
+        return true;
+    }
+
+    // the part is open, when p1 is inside
+    inline void addLine( const QPointF& p1, const QPointF& p2,
+        QPolygonF& part, QVector< QPolygonF >& parts ) const
+    {
+        const int code1 = outCode( p1 );
+        const int code2 = outCode( p2 );
 
-                clippedPoints += p1;
+        if ( ( code1 | code2 ) == 0 )
+        {
+            part += p2;
+            return;
+        }
+
+        if ( code1 == Invalid || code2 == Invalid )
+        {
+            // a gap in the polyline
+            if ( code2 == 0 )
+                part += p2;
+            else
+                closePart( part, parts );
+
+            return;
+        }
+
+        if ( code1 & code2 )
+            return;
+
+        const double dx = p2.x() - p1.x();
+        const double dy = p2.y() - p1.y();
+
+        double t1 = 0.0;
+        double t2 = 1.0;
+
+        if ( clipT( -dx, p1.x() - m_x1, t1, t2 )
+            && clipT( dx, m_x2 - p1.x(), t1, t2 )
+            && clipT( -dy, p1.y() - m_y1, t1, t2 )
+            && clipT( dy, m_y2 - p1.y(), t1, t2 ) )
+        {
+            if ( code1 != 0 )
+                part += QPointF( p1.x() + t1 * dx, p1.y() + t1 * dy );
+
+            if ( code2 != 0 )
+            {
+                part += QPointF( p1.x() + t2 * dx, p1.y() + t2 * dy );
+                closePart( part, parts );
             }
-            else if ( edge.isInside( p2 ) )
+            else
             {
-                clippedPoints += edge.intersection( p1, p2 );
+                part += p2;
             }
         }
     }
 
-    const Rect m_clipRect;
+    static inline void closePart( QPolygonF& part, QVector< QPolygonF >& parts )
+    {
+        if ( part.size() >= 2 )
+            parts += part;
+
+        part = QPolygonF();
+    }
+
+    const double m_x1;
+    const double m_x2;
+    const double m_y1;
+    const double m_y2;
 };
 
 class QwtCircleClipper
@@ -461,6 +959,47 @@ QPolygonF QwtClipper::clippedPolygonF(
     return points;
 }
 
+/*!
+   Sutherland-Hodgman polygon clipping into a buffer
+
+   Passing the same buffer for each call avoids allocations, as its
+   capacity is kept. When all points are inside of the clip rectangle
+   the buffer is left empty and true is returned.
+
+   \param clipRect Clip rectangle
+   \param polygon Polygon
+   \param clippedPolygon Buffer for the clipped polygon
+   \param closePolygon True, when the polygon is closed
+
+   \return True, when the polygon is not affected by clipping
+ */
+bool QwtClipper::clipPolygonF( const QRectF& clipRect, const QPolygonF& polygon,
+    QPolygonF& clippedPolygon, bool closePolygon )
+{
+    QwtPolygonClipper< QPolygonF, QRectF, double > clipper( clipRect );
+    return clipper.clipPolygon( polygon, clippedPolygon, closePolygon );
+}
+
+/*!
+   Split a polyline into the parts, that are inside of a rectangle
+
+   In opposite to clipPolygonF(), where the polyline is continued
+   along the edges of the clip rectangle, each excursion
+   outside of the rectangle ends a part and the next part starts,
+   where the polyline enters the rectangle again.
+
+   \param clipRect Clip rectangle
+   \param polyline Polyline
+
+   \return Visible parts of the polyline
+ */
+QVector< QPolygonF > QwtClipper::splitPolylineF(
+    const QRectF& clipRect, const QPolygonF& polyline )
+{
+    QwtPolylineSplitter splitter( clipRect );
+    return splitter.split( polyline );
+}
+
 /*!
    Circle clipping
 
@@ -47,6 +47,12 @@ namespace QwtClipper
     QWT_EXPORT QPolygonF clippedPolygonF( const QRectF&,
         const QPolygonF&, bool closePolygon = false );
 
+    QWT_EXPORT bool clipPolygonF( const QRectF&, const QPolygonF&,
+        QPolygonF& clippedPolygon, bool closePolygon = false );
+
+    QWT_EXPORT QVector< QPolygonF > splitPolylineF(
+        const QRectF&, const QPolygonF& );
+
     QWT_EXPORT QVector< QwtInterval > clipCircle(
         const QRectF&, const QPointF&, double radius );
 };
@@ -12,6 +12,104 @@
 
 #include <qvector.h>
 
+#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+    ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define QWT_COLOR_MAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/*
+   The color index as it is calculated by QwtLinearColorMap::colorIndex():
+   offset is 0.5 for rounding and 0.0 for truncating.
+
+   Instead of the checks against the interval borders the index is clamped
+   to [0, maxIndex], what maps NaN values to 0 as well. The clamping
+   is done by min/max operations, so that there are no branches. Only
+   the upper border needs an explicit comparison, as ( max * width ) / width
+   might end up below max, what would matter when truncating.
+ */
+static void qwtColorIndexes( const double* values, uint* indexes, int count,
+    double minValue, double maxValue, int maxIndex, double offset )
+{
+    const double max = maxIndex;
+    const double width = maxValue - minValue;
+
+    int i = 0;
+
+#if QWT_COLOR_MAP_SSE2
+    {
+        const __m128d vMin = _mm_set1_pd( minValue );
+        const __m128d vWidth = _mm_set1_pd( width );
+        const __m128d vMax = _mm_set1_pd( max );
+        const __m128d vOffset = _mm_set1_pd( offset );
+        const __m128d vZero = _mm_setzero_pd();
+        const __m128d vMaxValue = _mm_set1_pd( maxValue );
+
+        for ( ; i + 1 < count; i += 2 )
+        {
+            const __m128d value = _mm_loadu_pd( values + i );
+
+            __m128d v = _mm_div_pd( _mm_mul_pd( vMax, _mm_sub_pd( value, vMin ) ), vWidth );
+            v = _mm_add_pd( v, vOffset );
+
+            // _mm_max_pd returns the second operand for NaN
+            v = _mm_min_pd( _mm_max_pd( v, vZero ), vMax );
+
+            const __m128d isMax = _mm_cmpge_pd( value, vMaxValue );
+            v = _mm_or_pd( _mm_and_pd( isMax, vMax ), _mm_andnot_pd( isMax, v ) );
+
+            _mm_storel_epi64( reinterpret_cast< __m128i* >( indexes + i ),
+                _mm_cvttpd_epi32( v ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+    {
+        double v = ( max * ( values[i] - minValue ) ) / width + offset;
+
+        v = ( v > 0.0 ) ? v : 0.0;
+        v = ( v < max ) ? v : max;
+        v = ( values[i] >= maxValue ) ? max : v;
+
+        indexes[i] = static_cast< uint >( v );
+    }
+}
+
+/*
+   Lookup of values in a table of size equidistant colors. Values
+   outside of the interval are clamped to the first/last color,
+   NaN values are mapped to 0u - both without branches.
+ */
+static void qwtLookupRgbs( const QRgb* table, int size,
+    const QwtInterval& interval, const double* values, QRgb* rgbs, int count )
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        for ( int i = 0; i < count; i++ )
+            rgbs[i] = 0u;
+
+        return;
+    }
+
+    const double minValue = interval.minValue();
+    const double maxIndex = size - 1;
+    const double factor = maxIndex / width;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+
+        double v = ( value - minValue ) * factor + 0.5;
+        v = ( v > 0.0 ) ? v : 0.0;
+        v = ( v < maxIndex ) ? v : maxIndex;
+
+        const QRgb rgb = table[ static_cast< int >( v ) ];
+        rgbs[i] = ( value == value ) ? rgb : 0u;
+    }
+}
+
 static inline QRgb qwtHsvToRgb( int h, int s, int v, int a )
 {
 #if 0
@@ -242,6 +340,18 @@ inline QRgb QwtLinearColorMap::ColorStops::rgb(
     }
 }
 
+class QwtColorMap::PrivateData
+{
+  public:
+    PrivateData()
+        : lookupTableSize( 0 )
+    {
+    }
+
+    int lookupTableSize;
+    QVector< QRgb > lookupTable;
+};
+
 /*!
    Constructor
    \param format Format of the color map
@@ -249,11 +359,13 @@ inline QRgb QwtLinearColorMap::ColorStops::rgb(
 QwtColorMap::QwtColorMap( Format format )
     : m_format( format )
 {
+    m_data = new PrivateData;
 }
 
 //! Destructor
 QwtColorMap::~QwtColorMap()
 {
+    delete m_data;
 }
 
 /*!
@@ -293,6 +405,123 @@ uint QwtColorMap::colorIndex( int numColors,
     return static_cast< unsigned int >( v + 0.5 );
 }
 
+/*!
+   \brief Map an array of values into RGB values
+
+   Rendering an image maps the values of all pixels of a row. Color maps,
+   that can avoid the overhead of calling rgb() for each value,
+   should reimplement rgbRow().
+
+   The default implementation calls rgb() for each value - or looks
+   up the colors in the lookup table, when lookupTableSize() > 0.
+
+   \param interval Range for all values
+   \param values Values to be mapped
+   \param rgbs Array for the RGB values, at least count elements
+   \param count Number of values
+
+   \note NaN values are mapped to 0u ( transparent )
+   \sa rgb(), colorIndexRow()
+ */
+void QwtColorMap::rgbRow( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int count ) const
+{
+    if ( m_data->lookupTableSize > 0 )
+    {
+        qwtLookupRgbs( m_data->lookupTable.constData(),
+            m_data->lookupTableSize, interval, values, rgbs, count );
+
+        return;
+    }
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+        rgbs[i] = ( value == value ) ? rgb( interval, value ) : 0u; // NaN
+    }
+}
+
+/*!
+   \brief Enable a lookup table for rgbRow()
+
+   Calculating a color can be expensive - f.e. QwtLinearColorMap
+   has to find the color stops and interpolate between them. With
+   a lookup table the value is quantized into one of size equidistant
+   steps and mapping it is a single load from the table.
+
+   The size should be chosen according to the resolution needed for
+   the color gradient: each entry covers 1 / ( size - 1 ) of the interval.
+   For a smooth gradient on screen 1024 entries are usually enough.
+
+   The table is built from colorTable() and is rebuilt, whenever
+   the parameters of the color map change.
+
+   \param size Number of entries, 0 disables the table
+   \sa lookupTableSize(), rgbRow(), updateLookupTable()
+
+   \note The table is used by rgbRow() only, rgb() is always calculated
+ */
+void QwtColorMap::setLookupTableSize( int size )
+{
+    if ( size < 2 )
+        size = 0;
+
+    if ( size != m_data->lookupTableSize )
+    {
+        m_data->lookupTableSize = size;
+        updateLookupTable();
+    }
+}
+
+/*!
+   \return Number of entries of the lookup table, 0 when disabled
+   \sa setLookupTableSize()
+ */
+int QwtColorMap::lookupTableSize() const
+{
+    return m_data->lookupTableSize;
+}
+
+/*!
+   \brief Rebuild the lookup table
+
+   Derived classes have to call updateLookupTable(), whenever the
+   parameters, that have an effect on rgb(), have been changed.
+
+   \sa setLookupTableSize()
+ */
+void QwtColorMap::updateLookupTable()
+{
+    if ( m_data->lookupTableSize > 0 )
+        m_data->lookupTable = colorTable( m_data->lookupTableSize );
+    else
+        m_data->lookupTable.clear();
+}
+
+/*!
+   \brief Map an array of values into color indexes
+
+   The default implementation calls colorIndex() for each value.
+
+   \param numColors Number of colors
+   \param interval Range for all values
+   \param values Values to be mapped
+   \param indexes Array for the indexes, at least count elements
+   \param count Number of values
+
+   \note NaN values are mapped to 0
+   \sa colorIndex(), rgbRow()
+ */
+void QwtColorMap::colorIndexRow( int numColors, const QwtInterval& interval,
+    const double* values, uint* indexes, int count ) const
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+        indexes[i] = ( value == value ) ? colorIndex( numColors, interval, value ) : 0;
+    }
+}
+
 /*!
    Build and return a color map of 256 colors
 
@@ -391,6 +620,8 @@ QwtLinearColorMap::~QwtLinearColorMap()
 void QwtLinearColorMap::setMode( Mode mode )
 {
     m_data->mode = mode;
+
+    updateLookupTable();
 }
 
 /*!
@@ -418,6 +649,8 @@ void QwtLinearColorMap::setColorInterval(
     m_data->colorStops = ColorStops();
     m_data->colorStops.insert( 0.0, color1 );
     m_data->colorStops.insert( 1.0, color2 );
+
+    updateLookupTable();
 }
 
 /*!
@@ -434,6 +667,8 @@ void QwtLinearColorMap::addColorStop( double value, const QColor& color )
 {
     if ( value >= 0.0 && value <= 1.0 )
         m_data->colorStops.insert( value, color );
+
+    updateLookupTable();
 }
 
 /*!
@@ -508,6 +743,74 @@ uint QwtLinearColorMap::colorIndex( int numColors,
     return static_cast< unsigned int >( ( m_data->mode == FixedColors ) ? v : v + 0.5 );
 }
 
+/*!
+   \brief Map an array of values into RGB values
+
+   \param interval Range for all values
+   \param values Values to be mapped
+   \param rgbs Array for the RGB values, at least count elements
+   \param count Number of values
+
+   \note NaN values are mapped to 0u ( transparent )
+ */
+void QwtLinearColorMap::rgbRow( const QwtInterval& interval,
+    const double* values, QRgb* rgbs, int count ) const
+{
+    if ( lookupTableSize() > 0 )
+    {
+        QwtColorMap::rgbRow( interval, values, rgbs, count );
+        return;
+    }
+
+    const double width = interval.width();
+    const double minValue = interval.minValue();
+
+    const ColorStops& colorStops = m_data->colorStops;
+    const Mode mode = m_data->mode;
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const double value = values[i];
+
+        if ( width <= 0.0 || value != value )
+            rgbs[i] = 0u;
+        else
+            rgbs[i] = colorStops.rgb( mode, ( value - minValue ) / width );
+    }
+}
+
+/*!
+   \brief Map an array of values into color indexes
+
+   The indexes are calculated without branches and - when
+   available - 2 values at once using SSE2.
+
+   \param numColors Size of the color table
+   \param interval Range for all values
+   \param values Values to be mapped
+   \param indexes Array for the indexes, at least count elements
+   \param count Number of values
+
+   \note NaN values are mapped to 0
+ */
+void QwtLinearColorMap::colorIndexRow( int numColors, const QwtInterval& interval,
+    const double* values, uint* indexes, int count ) const
+{
+    const double width = interval.width();
+    if ( width <= 0.0 )
+    {
+        for ( int i = 0; i < count; i++ )
+            indexes[i] = 0;
+
+        return;
+    }
+
+    const double offset = ( m_data->mode == FixedColors ) ? 0.0 : 0.5;
+
+    qwtColorIndexes( values, indexes, count,
+        interval.minValue(), interval.maxValue(), numColors - 1, offset );
+}
+
 class QwtAlphaColorMap::PrivateData
 {
   public:
@@ -562,6 +865,8 @@ void QwtAlphaColorMap::setColor( const QColor& color )
 
     m_data->rgbMin = m_data->rgb | ( m_data->alpha1 << 24 );
     m_data->rgbMax = m_data->rgb | ( m_data->alpha2 << 24 );
+
+    updateLookupTable();
 }
 
 /*!
@@ -591,6 +896,8 @@ void QwtAlphaColorMap::setAlphaInterval( int alpha1, int alpha2 )
 
     m_data->rgbMin = m_data->rgb | ( alpha1 << 24 );
     m_data->rgbMax = m_data->rgb | ( alpha2 << 24 );
+
+    updateLookupTable();
 }
 
 /*!
@@ -750,6 +1057,8 @@ void QwtHueColorMap::setHueInterval( int hue1, int hue2 )
 
     m_data->rgbMin = m_data->rgbTable[ hue1 % 360 ];
     m_data->rgbMax = m_data->rgbTable[ hue2 % 360 ];
+
+    updateLookupTable();
 }
 
 /*!
@@ -770,6 +1079,8 @@ void QwtHueColorMap::setSaturation( int saturation )
         m_data->saturation = saturation;
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -790,6 +1101,8 @@ void QwtHueColorMap::setValue( int value )
         m_data->value = value;
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -811,6 +1124,8 @@ void QwtHueColorMap::setAlpha( int alpha )
         m_data->alpha = alpha;
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -998,6 +1313,8 @@ void QwtSaturationValueColorMap::setHue( int hue )
         m_data->hue = hue;
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -1026,6 +1343,8 @@ void QwtSaturationValueColorMap::setSaturationInterval(
 
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -1052,6 +1371,8 @@ void QwtSaturationValueColorMap::setValueInterval( int value1, int value2 )
 
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
@@ -1073,6 +1394,8 @@ void QwtSaturationValueColorMap::setAlpha( int alpha )
         m_data->alpha = alpha;
         m_data->updateTable();
     }
+
+    updateLookupTable();
 }
 
 /*!
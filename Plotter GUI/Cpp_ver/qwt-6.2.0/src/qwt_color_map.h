@@ -78,14 +78,29 @@ class QWT_EXPORT QwtColorMap
     virtual uint colorIndex( int numColors,
         const QwtInterval& interval, double value ) const;
 
+    virtual void rgbRow( const QwtInterval&,
+        const double* values, QRgb* rgbs, int count ) const;
+
+    virtual void colorIndexRow( int numColors, const QwtInterval&,
+        const double* values, uint* indexes, int count ) const;
+
     QColor color( const QwtInterval&, double value ) const;
     virtual QVector< QRgb > colorTable( int numColors ) const;
     virtual QVector< QRgb > colorTable256() const;
 
+    void setLookupTableSize( int size );
+    int lookupTableSize() const;
+
+  protected:
+    void updateLookupTable();
+
   private:
     Q_DISABLE_COPY(QwtColorMap)
 
     Format m_format;
+
+    class PrivateData;
+    PrivateData* m_data;
 };
 
 /*!
@@ -134,6 +149,12 @@ class QWT_EXPORT QwtLinearColorMap : public QwtColorMap
     virtual uint colorIndex( int numColors,
         const QwtInterval&, double value ) const QWT_OVERRIDE;
 
+    virtual void rgbRow( const QwtInterval&,
+        const double* values, QRgb* rgbs, int count ) const QWT_OVERRIDE;
+
+    virtual void colorIndexRow( int numColors, const QwtInterval&,
+        const double* values, uint* indexes, int count ) const QWT_OVERRIDE;
+
     class ColorStops;
 
   private:
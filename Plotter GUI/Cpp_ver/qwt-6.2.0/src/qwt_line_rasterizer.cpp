@@ -0,0 +1,714 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_line_rasterizer.h"
+#include "qwt_math.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qimage.h>
+#include <qcolor.h>
+#include <qrect.h>
+#include <qnumeric.h>
+#include <qvector.h>
+
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// less points are not worth a thread
+static const int qwtMinPointsPerThread = 10000;
+
+// the same rounding as the raster paint engine
+static inline uint qwtByteMul( uint x, uint a )
+{
+    uint t = ( x & 0xff00ff ) * a;
+    t = ( t + ( ( t >> 8 ) & 0xff00ff ) + 0x800080 ) >> 8;
+    t &= 0xff00ff;
+
+    x = ( ( x >> 8 ) & 0xff00ff ) * a;
+    x = ( x + ( ( x >> 8 ) & 0xff00ff ) + 0x800080 );
+    x &= 0xff00ff00;
+
+    return x | t;
+}
+
+static inline bool qwtIsSupportedFormat( const QImage& image )
+{
+    return image.format() == QImage::Format_ARGB32_Premultiplied
+        || image.format() == QImage::Format_RGB32;
+}
+
+static inline qreal qwtDevicePixelRatio( const QPaintDevice* device )
+{
+#if QT_VERSION >= 0x050600
+    return device->devicePixelRatioF();
+#elif QT_VERSION >= 0x050000
+    return device->devicePixelRatio();
+#else
+    Q_UNUSED( device )
+    return 1.0;
+#endif
+}
+
+namespace
+{
+    /*
+        The lines of a polyline clipped to a band of rows. The pixels
+        of the target are captured once, so that the threads
+        don't detach the image.
+     */
+    class QwtRasterJob
+    {
+      public:
+        inline void blend( int x, int y, int coverage ) const
+        {
+            if ( x < clipRect.left() || x > clipRect.right()
+                || y < clipRect.top() || y > clipRect.bottom() )
+            {
+                return;
+            }
+
+            uint* dst = reinterpret_cast< uint* >( bits + y * bytesPerLine ) + x;
+
+            // source over of premultiplied pixels
+
+            const uint src = ( coverage >= 255 ) ? rgb : qwtByteMul( rgb, coverage );
+            const uint alpha = src >> 24;
+
+            if ( alpha == 255 )
+                *dst = src;
+            else if ( src != 0 )
+                *dst = ( src + qwtByteMul( *dst, 255 - alpha ) ) | opaqueMask;
+        }
+
+        uchar* bits;
+        int bytesPerLine;
+        uint opaqueMask;
+
+        const QPointF* points;
+        int numPoints;
+        QPointF offset;
+
+        uint rgb;
+        bool antialiased;
+
+        QRect clipRect;
+    };
+}
+
+/*
+   Lines are iterated along their major axis "u", the minor axis is "v".
+   The returned range of major coordinates [i1, i2] is limited to what
+   might have pixels inside of the clip rectangle.
+ */
+static inline bool qwtMajorRange( double u1, double u2, double v1, double m,
+    int uMin, int uMax, int vMin, int vMax, int& i1, int& i2 )
+{
+    double lo = u1;
+    double hi = u2;
+
+    if ( m == 0.0 )
+    {
+        if ( v1 < vMin - 1.0 || v1 > vMax + 2.0 )
+            return false;
+    }
+    else
+    {
+        const double ua = u1 + ( vMin - 1.0 - v1 ) / m;
+        const double ub = u1 + ( vMax + 2.0 - v1 ) / m;
+
+        lo = qMax( lo, qMin( ua, ub ) );
+        hi = qMin( hi, qMax( ua, ub ) );
+    }
+
+    lo = qMax( lo, uMin - 1.0 );
+    hi = qMin( hi, uMax + 1.0 );
+
+    if ( lo > hi )
+        return false;
+
+    i1 = qMax( qwtFloor( lo ) - 1, uMin );
+    i2 = qMin( qwtCeil( hi ) + 1, uMax );
+
+    return i1 <= i2;
+}
+
+/*
+   Each pixel, where the line crosses the center line in the direction
+   of the minor axis. The pixel of the end point is left out, when it is
+   the start of the next line. As all pixels are calculated from the
+   end points only, the result does not depend on the clip rectangle.
+ */
+static void qwtRasterizeLine( const QwtRasterJob& job,
+    const QPointF& p1, const QPointF& p2, bool includeEnd )
+{
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+
+    if ( !( qIsFinite( dx ) && qIsFinite( dy ) ) )
+        return;
+
+    if ( dx == 0.0 && dy == 0.0 )
+        return;
+
+    const QRect& r = job.clipRect;
+    const bool xMajor = qAbs( dx ) >= qAbs( dy );
+
+    double u1, u2, v1, v2;
+    int uMin, uMax, vMin, vMax;
+
+    if ( xMajor )
+    {
+        u1 = p1.x(); v1 = p1.y();
+        u2 = p2.x(); v2 = p2.y();
+
+        uMin = r.left(); uMax = r.right();
+        vMin = r.top(); vMax = r.bottom();
+    }
+    else
+    {
+        u1 = p1.y(); v1 = p1.x();
+        u2 = p2.y(); v2 = p2.x();
+
+        uMin = r.top(); uMax = r.bottom();
+        vMin = r.left(); vMax = r.right();
+    }
+
+    bool includeStart = true;
+
+    if ( u2 < u1 )
+    {
+        qSwap( u1, u2 );
+        qSwap( v1, v2 );
+        qSwap( includeStart, includeEnd );
+    }
+
+    const double m = ( v2 - v1 ) / ( u2 - u1 );
+
+    int i1, i2;
+    if ( !qwtMajorRange( u1, u2, v1, m, uMin, uMax, vMin, vMax, i1, i2 ) )
+        return;
+
+    for ( int i = i1; i <= i2; i++ )
+    {
+        const double u = i + 0.5;
+
+        if ( u < u1 || u > u2 )
+            continue;
+
+        if ( ( u == u1 && !includeStart ) || ( u == u2 && !includeEnd ) )
+            continue;
+
+        const int j = qwtFloor( v1 + ( u - u1 ) * m );
+
+        if ( xMajor )
+            job.blend( i, j, 255 );
+        else
+            job.blend( j, i, 255 );
+    }
+}
+
+/*
+   The coverage of the pixels along the major axis is distributed
+   to the 2 pixels next to the line like in Xiaolin Wu's algorithm.
+   The coverage of a pixel at the end is reduced by the part of the
+   pixel, that is not covered by the line, so that the pixels of
+   connected lines add up.
+ */
+static void qwtRasterizeLineAA( const QwtRasterJob& job,
+    const QPointF& p1, const QPointF& p2 )
+{
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+
+    if ( !( qIsFinite( dx ) && qIsFinite( dy ) ) )
+        return;
+
+    if ( dx == 0.0 && dy == 0.0 )
+        return;
+
+    const QRect& r = job.clipRect;
+    const bool xMajor = qAbs( dx ) >= qAbs( dy );
+
+    double u1, u2, v1, v2;
+    int uMin, uMax, vMin, vMax;
+
+    if ( xMajor )
+    {
+        u1 = p1.x(); v1 = p1.y();
+        u2 = p2.x(); v2 = p2.y();
+
+        uMin = r.left(); uMax = r.right();
+        vMin = r.top(); vMax = r.bottom();
+    }
+    else
+    {
+        u1 = p1.y(); v1 = p1.x();
+        u2 = p2.y(); v2 = p2.x();
+
+        uMin = r.top(); uMax = r.bottom();
+        vMin = r.left(); vMax = r.right();
+    }
+
+    if ( u2 < u1 )
+    {
+        qSwap( u1, u2 );
+        qSwap( v1, v2 );
+    }
+
+    const double m = ( v2 - v1 ) / ( u2 - u1 );
+
+    int i1, i2;
+    if ( !qwtMajorRange( u1, u2, v1, m, uMin, uMax, vMin, vMax, i1, i2 ) )
+        return;
+
+    for ( int i = i1; i <= i2; i++ )
+    {
+        const double w = qMin( u2, i + 1.0 ) - qMax( u1, double( i ) );
+        if ( w <= 0.0 )
+            continue;
+
+        const double u = qBound( u1, i + 0.5, u2 );
+        const double v = v1 + ( u - u1 ) * m - 0.5;
+
+        const int j = qwtFloor( v );
+        const double f = v - j;
+
+        const int coverage1 = qRound( w * ( 1.0 - f ) * 255.0 );
+        const int coverage2 = qRound( w * f * 255.0 );
+
+        if ( xMajor )
+        {
+            if ( coverage1 > 0 )
+                job.blend( i, j, coverage1 );
+
+            if ( coverage2 > 0 )
+                job.blend( i, j + 1, coverage2 );
+        }
+        else
+        {
+            if ( coverage1 > 0 )
+                job.blend( j, i, coverage1 );
+
+            if ( coverage2 > 0 )
+                job.blend( j + 1, i, coverage2 );
+        }
+    }
+}
+
+static void qwtRasterizeBand( const QwtRasterJob& job )
+{
+    // antialiased lines might touch the neighboured pixels
+    const double x1 = job.clipRect.left() - 1.0;
+    const double x2 = job.clipRect.right() + 2.0;
+    const double y1 = job.clipRect.top() - 1.0;
+    const double y2 = job.clipRect.bottom() + 2.0;
+
+    const QPointF* points = job.points;
+    const int numLines = job.numPoints - 1;
+
+    QPointF p1 = points[0] + job.offset;
+
+    for ( int i = 0; i < numLines; i++ )
+    {
+        const QPointF p2 = points[i + 1] + job.offset;
+
+        if ( !( ( p1.x() < x1 && p2.x() < x1 ) || ( p1.x() > x2 && p2.x() > x2 )
+            || ( p1.y() < y1 && p2.y() < y1 ) || ( p1.y() > y2 && p2.y() > y2 ) ) )
+        {
+            if ( job.antialiased )
+                qwtRasterizeLineAA( job, p1, p2 );
+            else
+                qwtRasterizeLine( job, p1, p2, i == numLines - 1 );
+        }
+
+        p1 = p2;
+    }
+}
+
+static void qwtRasterizePolyline( QImage* image,
+    const QPointF* points, int numPoints, const QPointF& offset,
+    QRgb rgb, bool antialiased, const QRect& clipRect, uint numThreads )
+{
+    const QRect rect = clipRect & image->rect();
+    if ( rect.isEmpty() || numPoints < 2 )
+        return;
+
+    QwtRasterJob job;
+    job.bits = image->bits();
+    job.bytesPerLine = image->bytesPerLine();
+    job.opaqueMask = ( image->format() == QImage::Format_RGB32 ) ? 0xff000000u : 0u;
+    job.points = points;
+    job.numPoints = numPoints;
+    job.offset = offset;
+    job.rgb = rgb;
+    job.antialiased = antialiased;
+    job.clipRect = rect;
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    int numBands = qMin( int( numThreads ), numPoints / qwtMinPointsPerThread );
+    numBands = qMin( numBands, rect.height() );
+
+    if ( numBands > 1 )
+    {
+        /*
+            Each thread rasterizes all lines, but only into its band
+            of rows. So the threads don't write to the same pixels
+            and the lines overlap in the order of the points.
+         */
+
+        QList< QFuture< void > > futures;
+
+        for ( int i = 0; i < numBands; i++ )
+        {
+            const int y1 = rect.top() + i * rect.height() / numBands;
+            const int y2 = rect.top() + ( i + 1 ) * rect.height() / numBands;
+
+            job.clipRect = QRect( rect.left(), y1, rect.width(), y2 - y1 );
+
+            if ( i == numBands - 1 )
+            {
+                // the last band in the current thread
+                qwtRasterizeBand( job );
+            }
+            else
+            {
+                futures += QtConcurrent::run( &qwtRasterizeBand, job );
+            }
+        }
+
+        for ( int i = 0; i < futures.size(); i++ )
+            futures[i].waitForFinished();
+
+        return;
+    }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    qwtRasterizeBand( job );
+}
+
+class QwtLineRasterizer::PrivateData
+{
+  public:
+    PrivateData()
+        : color( Qt::black )
+        , antialiased( false )
+        , numThreads( 1 )
+    {
+    }
+
+    QColor color;
+    bool antialiased;
+    QRect clipRect;
+    uint numThreads;
+};
+
+//! Constructor
+QwtLineRasterizer::QwtLineRasterizer()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtLineRasterizer::~QwtLineRasterizer()
+{
+    delete m_data;
+}
+
+/*!
+   Set the color for drawPolyline( QImage&, ... )
+
+   \param color Color
+   \sa color()
+ */
+void QwtLineRasterizer::setColor( const QColor& color )
+{
+    m_data->color = color;
+}
+
+/*!
+   \return Color for drawPolyline( QImage&, ... )
+   \sa setColor()
+ */
+QColor QwtLineRasterizer::color() const
+{
+    return m_data->color;
+}
+
+/*!
+   En/Disable antialiasing for drawPolyline( QImage&, ... )
+
+   \param on On/Off
+   \sa hasAntialiasing()
+ */
+void QwtLineRasterizer::setAntialiasing( bool on )
+{
+    m_data->antialiased = on;
+}
+
+/*!
+   \return True, when antialiasing is enabled
+   \sa setAntialiasing()
+ */
+bool QwtLineRasterizer::hasAntialiasing() const
+{
+    return m_data->antialiased;
+}
+
+/*!
+   Set the clip rectangle for drawPolyline( QImage&, ... )
+
+   \param rect Clip rectangle in pixels. An invalid rectangle
+               means no clipping beside the bounds of the image.
+
+   \sa clipRect()
+ */
+void QwtLineRasterizer::setClipRect( const QRect& rect )
+{
+    m_data->clipRect = rect;
+}
+
+/*!
+   \return Clip rectangle
+   \sa setClipRect()
+ */
+QRect QwtLineRasterizer::clipRect() const
+{
+    return m_data->clipRect;
+}
+
+/*!
+   \brief Set the number of threads for rasterizing a polyline
+
+   The image is split into horizontal bands, that are rasterized
+   in parallel. Threads are used for polylines with many points only.
+
+   \param numThreads Number of threads, where 0 means the system
+                     specific ideal thread count
+
+   \sa threadCount()
+ */
+void QwtLineRasterizer::setThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads, where 0 means the system
+           specific ideal thread count
+   \sa setThreadCount()
+ */
+uint QwtLineRasterizer::threadCount() const
+{
+    return m_data->numThreads;
+}
+
+/*!
+   \brief Rasterize a polyline into an image
+
+   The polyline is drawn with a width of one pixel, using color(),
+   hasAntialiasing() and clipRect(). The pixels of images in the formats
+   QImage::Format_ARGB32_Premultiplied or QImage::Format_RGB32 are
+   written directly, for all other formats the polyline is composed
+   by QPainter from an intermediate image.
+
+   \param image Image
+   \param points Points of the polyline in pixel coordinates
+   \param pointCount Number of points
+ */
+void QwtLineRasterizer::drawPolyline( QImage& image,
+    const QPointF* points, int pointCount ) const
+{
+    if ( pointCount < 2 || image.isNull() )
+        return;
+
+    if ( !qwtIsSupportedFormat( image ) )
+    {
+        QPainter painter( &image );
+
+        QPen pen( m_data->color );
+        pen.setWidth( 0 );
+        pen.setCosmetic( true );
+
+        painter.setPen( pen );
+        painter.setRenderHint( QPainter::Antialiasing, m_data->antialiased );
+
+        if ( m_data->clipRect.isValid() )
+            painter.setClipRect( m_data->clipRect );
+
+        drawPolyline( &painter, points, pointCount );
+        return;
+    }
+
+    const QRect clipRect = m_data->clipRect.isValid()
+        ? m_data->clipRect : image.rect();
+
+    qwtRasterizePolyline( &image, points, pointCount, QPointF(),
+        qPremultiply( m_data->color.rgba() ), m_data->antialiased,
+        clipRect, m_data->numThreads );
+}
+
+/*!
+   \brief Rasterize a polyline for a painter
+
+   The polyline is rasterized with the color and the antialiasing
+   hint of the painter, when isSupported() is true. When the paint
+   device is an image in the format QImage::Format_ARGB32_Premultiplied
+   or QImage::Format_RGB32 its pixels are written directly, otherwise the
+   polyline is composed from an intermediate image.
+
+   \param painter Painter
+   \param points Points of the polyline
+   \param pointCount Number of points
+
+   \return False, when the polyline can't be rasterized for the painter
+           and has to be drawn by QPainter.
+ */
+bool QwtLineRasterizer::drawPolyline( QPainter* painter,
+    const QPointF* points, int pointCount ) const
+{
+    if ( !isSupported( painter ) )
+        return false;
+
+    if ( pointCount < 2 )
+        return true;
+
+    QColor color = painter->pen().color();
+    color.setAlphaF( color.alphaF() * painter->opacity() );
+
+    if ( color.alpha() == 0 )
+        return true;
+
+    const QRgb rgb = qPremultiply( color.rgba() );
+    const bool antialiased = painter->testRenderHint( QPainter::Antialiasing );
+
+    const QTransform transform = painter->transform();
+    const QPointF offset( transform.dx(), transform.dy() );
+
+    QPaintDevice* device = painter->device();
+
+    QRect clipRect;
+    if ( device->devType() == QInternal::Image )
+        clipRect = static_cast< QImage* >( device )->rect();
+    else
+        clipRect.setRect( 0, 0, device->width(), device->height() );
+
+    if ( painter->hasClipping() )
+    {
+        const QRectF r = transform.mapRect(
+            QRectF( painter->clipRegion().boundingRect() ) );
+
+        clipRect &= r.toAlignedRect();
+    }
+
+    if ( device->devType() == QInternal::Image )
+    {
+        QImage* image = static_cast< QImage* >( device );
+
+        if ( image->isDetached() && qwtIsSupportedFormat( *image ) )
+        {
+            qwtRasterizePolyline( image, points, pointCount, offset,
+                rgb, antialiased, clipRect, m_data->numThreads );
+
+            return true;
+        }
+    }
+
+    // rasterizing into an intermediate image, that is painted in one go
+
+    double minX = points[0].x();
+    double maxX = minX;
+    double minY = points[0].y();
+    double maxY = minY;
+
+    for ( int i = 1; i < pointCount; i++ )
+    {
+        minX = qMin( minX, points[i].x() );
+        maxX = qMax( maxX, points[i].x() );
+        minY = qMin( minY, points[i].y() );
+        maxY = qMax( maxY, points[i].y() );
+    }
+
+    const QRectF boundingRect = QRectF( minX, minY,
+        maxX - minX, maxY - minY ).translated( offset );
+
+    const QRect layerRect = clipRect
+        & boundingRect.toAlignedRect().adjusted( -1, -1, 1, 1 );
+
+    if ( layerRect.isEmpty() )
+        return true;
+
+    QImage layer( layerRect.size(), QImage::Format_ARGB32_Premultiplied );
+    layer.fill( 0 );
+
+    qwtRasterizePolyline( &layer, points, pointCount,
+        offset - layerRect.topLeft(), rgb, antialiased,
+        layer.rect(), m_data->numThreads );
+
+    painter->save();
+    painter->resetTransform();
+    painter->setOpacity( 1.0 );
+    painter->drawImage( layerRect.topLeft(), layer );
+    painter->restore();
+
+    return true;
+}
+
+/*!
+   \brief Check if polylines can be rasterized for a painter
+
+   Supported is a solid pen with a width of one pixel or less,
+   when painting with the raster paint engine, a transformation,
+   that is not more than a translation, a device pixel ratio of 1,
+   the QPainter::CompositionMode_SourceOver and no clipping or a
+   clip region, that is a rectangle.
+
+   \param painter Painter
+   \return True, when QwtLineRasterizer can draw for the painter
+ */
+bool QwtLineRasterizer::isSupported( const QPainter* painter )
+{
+    if ( painter == NULL || !painter->isActive() )
+        return false;
+
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::Raster )
+        return false;
+
+    const QPen pen = painter->pen();
+    if ( pen.style() != Qt::SolidLine || pen.brush().style() != Qt::SolidPattern )
+        return false;
+
+    if ( pen.widthF() > 1.0 )
+        return false;
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    if ( qwtDevicePixelRatio( painter->device() ) != 1.0 )
+        return false;
+
+    if ( painter->compositionMode() != QPainter::CompositionMode_SourceOver )
+        return false;
+
+    if ( painter->hasClipping() && painter->clipRegion().rectCount() > 1 )
+        return false;
+
+    return true;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_LINE_RASTERIZER_H
+#define QWT_LINE_RASTERIZER_H
+
+#include "qwt_global.h"
+
+class QPainter;
+class QImage;
+class QPointF;
+class QColor;
+class QRect;
+
+/*!
+   \brief A rasterizer for thin solid polylines
+
+   QwtLineRasterizer writes polylines with a width of one pixel directly
+   into the pixels of a QImage, bypassing the stroking of QPainter.
+   Lines are rasterized with a DDA algorithm or - when antialiasing
+   is enabled - with coverage values similar to Xiaolin Wu's algorithm.
+
+   For huge polylines the image can be split into horizontal bands,
+   that are rasterized in parallel ( setThreadCount() ).
+
+   The result is not pixel identical to what QPainter would render,
+   but for polylines with many points it is significantly faster.
+
+   \sa QwtPlotCurve::RasterizeLines
+ */
+class QWT_EXPORT QwtLineRasterizer
+{
+  public:
+    QwtLineRasterizer();
+    ~QwtLineRasterizer();
+
+    void setColor( const QColor& );
+    QColor color() const;
+
+    void setAntialiasing( bool );
+    bool hasAntialiasing() const;
+
+    void setClipRect( const QRect& );
+    QRect clipRect() const;
+
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
+    void drawPolyline( QImage&, const QPointF*, int pointCount ) const;
+    bool drawPolyline( QPainter*, const QPointF*, int pointCount ) const;
+
+    static bool isSupported( const QPainter* );
+
+  private:
+    Q_DISABLE_COPY(QwtLineRasterizer)
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
@@ -13,34 +13,230 @@
 #include <qvector.h>
 #include <qnumeric.h>
 #include <qrect.h>
+#include <qthreadstorage.h>
 
-static inline double qwtHermiteInterpolate(
-    double A, double B, double C, double D, double t )
+#include <algorithm>
+
+namespace
+{
+    /*
+        Indexes and weights of the matrix cells, that contribute
+        to the value at a position: 2 for bilinear and 4 for
+        bicubic interpolation. An index[0] < 0 indicates a
+        position outside of the matrix.
+     */
+    class QwtResampleTaps
+    {
+      public:
+        int index[4];
+        double weight[4];
+    };
+
+    /*
+        Buffers for resampling a grid. They are kept for each thread,
+        so that the bands of rows of a tile, that are requested
+        one after the other, don't allocate them again.
+     */
+    class QwtResampleBuffers
+    {
+      public:
+        QVector< QwtResampleTaps > columnTaps;
+        QVector< QwtResampleTaps > rowTaps;
+
+        QVector< int > matrixRows;
+        QVector< double > rows;
+    };
+}
+
+static QwtResampleBuffers& qwtResampleBuffers()
+{
+    static QThreadStorage< QwtResampleBuffers* > storage;
+
+    if ( !storage.hasLocalData() )
+        storage.setLocalData( new QwtResampleBuffers() );
+
+    return *storage.localData();
+}
+
+static inline void qwtLinearTaps( double pos,
+    double min, double step, int count, QwtResampleTaps& taps )
+{
+    int i1 = qRound( ( pos - min ) / step ) - 1;
+    int i2 = i1 + 1;
+
+    if ( i1 < 0 )
+        i1 = i2;
+    else if ( i2 >= count )
+        i2 = i1;
+
+    const double pos2 = min + ( i2 + 0.5 ) * step;
+    const double r = ( pos2 - pos ) / step;
+
+    taps.index[0] = i1;
+    taps.index[1] = i2;
+
+    taps.weight[0] = r;
+    taps.weight[1] = 1.0 - r;
+}
+
+static inline void qwtCubicTaps( double pos,
+    double min, double step, int count, QwtResampleTaps& taps )
 {
+    const double f = ( pos - min ) / step;
+    const int i = qRound( f );
+
+    int i0 = i - 2;
+    int i1 = i - 1;
+    int i2 = i;
+    int i3 = i + 1;
+
+    if ( i1 < 0 )
+        i1 = i2;
+
+    if ( i0 < 0 )
+        i0 = i1;
+
+    if ( i2 >= count )
+        i2 = i1;
+
+    if ( i3 >= count )
+        i3 = i2;
+
+    taps.index[0] = i0;
+    taps.index[1] = i1;
+    taps.index[2] = i2;
+    taps.index[3] = i3;
+
+    // the weights of the hermite interpolation between i1 and i2
+
+    const double t = f - i + 0.5;
     const double t2 = t * t;
     const double t3 = t2 * t;
 
-    const double a = -A / 2.0 + ( 3.0 * B ) / 2.0 - ( 3.0 * C ) / 2.0 + D / 2.0;
-    const double b = A - ( 5.0 * B ) / 2.0 + 2.0 * C - D / 2.0;
-    const double c = -A / 2.0 + C / 2.0;
-    const double d = B;
+    taps.weight[0] = -0.5 * t3 + t2 - 0.5 * t;
+    taps.weight[1] = 1.5 * t3 - 2.5 * t2 + 1.0;
+    taps.weight[2] = -1.5 * t3 + 2.0 * t2 + 0.5 * t;
+    taps.weight[3] = 0.5 * t3 - 0.5 * t2;
+}
 
-    return a * t3 + b * t2 + c * t + d;
+template< int numTaps >
+static inline double qwtResampleValue( const double* matrix, int numColumns,
+    const QwtResampleTaps& columnTaps, const QwtResampleTaps& rowTaps )
+{
+    // the same order of operations as in qwtResampleGrid
+
+    double value = 0.0;
+
+    for ( int k = 0; k < numTaps; k++ )
+    {
+        const double* row = matrix + rowTaps.index[k] * numColumns;
+
+        double v = 0.0;
+        for ( int j = 0; j < numTaps; j++ )
+            v += columnTaps.weight[j] * row[ columnTaps.index[j] ];
+
+        value += rowTaps.weight[k] * v;
+    }
+
+    return value;
 }
 
-static inline double qwtBicubicInterpolate(
-    double v00, double v10, double v20, double v30,
-    double v01, double v11, double v21, double v31,
-    double v02, double v12, double v22, double v32,
-    double v03, double v13, double v23, double v33,
-    double dx, double dy )
+/*
+    Separable resampling of a grid: the matrix rows, that are needed
+    for the grid, are interpolated at all x positions first. Then the
+    values of the grid are interpolated from these rows.
+
+    The horizontal pass is done once for each matrix row instead of
+    once for each value of the grid, what makes a difference, when a
+    matrix cell covers many pixels.
+ */
+template< int numTaps >
+static void qwtResampleGrid( const double* matrix, int matrixColumns,
+    QwtResampleBuffers& buffers, double* values )
 {
-    const double v0 = qwtHermiteInterpolate( v00, v10, v20, v30, dx );
-    const double v1 = qwtHermiteInterpolate( v01, v11, v21, v31, dx );
-    const double v2 = qwtHermiteInterpolate( v02, v12, v22, v32, dx );
-    const double v3 = qwtHermiteInterpolate( v03, v13, v23, v33, dx );
+    const QVector< QwtResampleTaps >& columnTaps = buffers.columnTaps;
+    const QVector< QwtResampleTaps >& rowTaps = buffers.rowTaps;
+
+    const int numColumns = columnTaps.size();
+    const int numRows = rowTaps.size();
+
+    QVector< int >& matrixRows = buffers.matrixRows;
+    matrixRows.clear();
+    matrixRows.reserve( numTaps * numRows );
+
+    for ( int r = 0; r < numRows; r++ )
+    {
+        if ( rowTaps[r].index[0] >= 0 )
+        {
+            for ( int k = 0; k < numTaps; k++ )
+                matrixRows += rowTaps[r].index[k];
+        }
+    }
+
+    std::sort( matrixRows.begin(), matrixRows.end() );
+    matrixRows.erase( std::unique( matrixRows.begin(), matrixRows.end() ),
+        matrixRows.end() );
+
+    // horizontal pass
+
+    QVector< double >& rows = buffers.rows;
+    rows.resize( matrixRows.size() * numColumns );
+
+    for ( int i = 0; i < matrixRows.size(); i++ )
+    {
+        const double* in = matrix + matrixRows[i] * matrixColumns;
+        double* out = rows.data() + i * numColumns;
+
+        for ( int j = 0; j < numColumns; j++ )
+        {
+            const QwtResampleTaps& taps = columnTaps[j];
+            if ( taps.index[0] < 0 )
+            {
+                out[j] = qQNaN();
+                continue;
+            }
+
+            double v = 0.0;
+            for ( int k = 0; k < numTaps; k++ )
+                v += taps.weight[k] * in[ taps.index[k] ];
+
+            out[j] = v;
+        }
+    }
+
+    // vertical pass
+
+    for ( int r = 0; r < numRows; r++ )
+    {
+        double* out = values + r * numColumns;
+
+        const QwtResampleTaps& taps = rowTaps[r];
+        if ( taps.index[0] < 0 )
+        {
+            for ( int j = 0; j < numColumns; j++ )
+                out[j] = qQNaN();
+
+            continue;
+        }
 
-    return qwtHermiteInterpolate( v0, v1, v2, v3, dy );
+        const double* in[numTaps];
+        for ( int k = 0; k < numTaps; k++ )
+        {
+            const int slot = std::lower_bound( matrixRows.constBegin(),
+                matrixRows.constEnd(), taps.index[k] ) - matrixRows.constBegin();
+
+            in[k] = rows.constData() + slot * numColumns;
+        }
+
+        for ( int j = 0; j < numColumns; j++ )
+        {
+            double v = 0.0;
+            for ( int k = 0; k < numTaps; k++ )
+                v += taps.weight[k] * in[k][j];
+
+            out[j] = v;
+        }
+    }
 }
 
 class QwtMatrixRasterData::PrivateData
@@ -57,6 +253,26 @@ class QwtMatrixRasterData::PrivateData
         return values.data()[ row * numColumns + col ];
     }
 
+    inline void columnTaps( double x, QwtResampleTaps& taps ) const
+    {
+        const double x0 = intervals[Qt::XAxis].minValue();
+
+        if ( resampleMode == QwtMatrixRasterData::BicubicInterpolation )
+            qwtCubicTaps( x, x0, dx, numColumns, taps );
+        else
+            qwtLinearTaps( x, x0, dx, numColumns, taps );
+    }
+
+    inline void rowTaps( double y, QwtResampleTaps& taps ) const
+    {
+        const double y0 = intervals[Qt::YAxis].minValue();
+
+        if ( resampleMode == QwtMatrixRasterData::BicubicInterpolation )
+            qwtCubicTaps( y, y0, dy, numRows, taps );
+        else
+            qwtLinearTaps( y, y0, dy, numRows, taps );
+    }
+
     QwtInterval intervals[3];
     QwtMatrixRasterData::ResampleMode resampleMode;
 
@@ -266,135 +482,180 @@ double QwtMatrixRasterData::value( double x, double y ) const
     switch( m_data->resampleMode )
     {
         case BicubicInterpolation:
+        case BilinearInterpolation:
         {
-            const double colF = ( x - xInterval.minValue() ) / m_data->dx;
-            const double rowF = ( y - yInterval.minValue() ) / m_data->dy;
+            QwtResampleTaps columnTaps, rowTaps;
+            m_data->columnTaps( x, columnTaps );
+            m_data->rowTaps( y, rowTaps );
+
+            const double* matrix = m_data->values.constData();
+
+            if ( m_data->resampleMode == BicubicInterpolation )
+            {
+                value = qwtResampleValue< 4 >( matrix,
+                    m_data->numColumns, columnTaps, rowTaps );
+            }
+            else
+            {
+                value = qwtResampleValue< 2 >( matrix,
+                    m_data->numColumns, columnTaps, rowTaps );
+            }
 
-            const int col = qRound( colF );
-            const int row = qRound( rowF );
+            break;
+        }
+        case NearestNeighbour:
+        default:
+        {
+            int row = int( ( y - yInterval.minValue() ) / m_data->dy );
+            int col = int( ( x - xInterval.minValue() ) / m_data->dx );
 
-            int col0 = col - 2;
-            int col1 = col - 1;
-            int col2 = col;
-            int col3 = col + 1;
+            // In case of intervals, where the maximum is included
+            // we get out of bound for row/col, when the value for the
+            // maximum is requested. Instead we return the value
+            // from the last row/col
 
-            if ( col1 < 0 )
-                col1 = col2;
+            if ( row >= m_data->numRows )
+                row = m_data->numRows - 1;
 
-            if ( col0 < 0 )
-                col0 = col1;
+            if ( col >= m_data->numColumns )
+                col = m_data->numColumns - 1;
 
-            if ( col2 >= m_data->numColumns )
-                col2 = col1;
+            value = m_data->value( row, col );
+        }
+    }
 
-            if ( col3 >= m_data->numColumns )
-                col3 = col2;
+    return value;
+}
 
-            int row0 = row - 2;
-            int row1 = row - 1;
-            int row2 = row;
-            int row3 = row + 1;
+/*!
+   \brief Values of a row of raster positions
 
-            if ( row1 < 0 )
-                row1 = row2;
+   For NearestNeighbour the row of the matrix is found only once
+   for all positions. The interpolating modes are implemented
+   by gridValues().
 
-            if ( row0 < 0 )
-                row0 = row1;
+   \param x Array of x values in plot coordinates
+   \param y Y value in plot coordinates
+   \param values Array for the values, at least count elements
+   \param count Number of positions
 
-            if ( row2 >= m_data->numRows )
-                row2 = row1;
+   \note Derived classes, that reimplement value(), need to
+         reimplement rowValues() and gridValues() as well
 
-            if ( row3 >= m_data->numRows )
-                row3 = row2;
+   \sa value(), gridValues(), ResampleMode
+ */
+void QwtMatrixRasterData::rowValues( const double* x, double y,
+    double* values, int count ) const
+{
+    if ( m_data->resampleMode != NearestNeighbour )
+    {
+        gridValues( x, count, &y, 1, values );
+        return;
+    }
 
-            // First row
-            const double v00 = m_data->value( row0, col0 );
-            const double v10 = m_data->value( row0, col1 );
-            const double v20 = m_data->value( row0, col2 );
-            const double v30 = m_data->value( row0, col3 );
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
 
-            // Second row
-            const double v01 = m_data->value( row1, col0 );
-            const double v11 = m_data->value( row1, col1 );
-            const double v21 = m_data->value( row1, col2 );
-            const double v31 = m_data->value( row1, col3 );
+    if ( !yInterval.contains( y ) )
+    {
+        for ( int i = 0; i < count; i++ )
+            values[i] = qQNaN();
 
-            // Third row
-            const double v02 = m_data->value( row2, col0 );
-            const double v12 = m_data->value( row2, col1 );
-            const double v22 = m_data->value( row2, col2 );
-            const double v32 = m_data->value( row2, col3 );
+        return;
+    }
 
-            // Fourth row
-            const double v03 = m_data->value( row3, col0 );
-            const double v13 = m_data->value( row3, col1 );
-            const double v23 = m_data->value( row3, col2 );
-            const double v33 = m_data->value( row3, col3 );
+    const double x0 = xInterval.minValue();
+    const double dx = m_data->dx;
+    const int maxCol = m_data->numColumns - 1;
 
-            value = qwtBicubicInterpolate(
-                v00, v10, v20, v30, v01, v11, v21, v31,
-                v02, v12, v22, v32, v03, v13, v23, v33,
-                colF - col + 0.5, rowF - row + 0.5 );
+    int row = int( ( y - yInterval.minValue() ) / m_data->dy );
+    if ( row >= m_data->numRows )
+        row = m_data->numRows - 1;
 
-            break;
-        }
-        case BilinearInterpolation:
-        {
-            int col1 = qRound( ( x - xInterval.minValue() ) / m_data->dx ) - 1;
-            int row1 = qRound( ( y - yInterval.minValue() ) / m_data->dy ) - 1;
-            int col2 = col1 + 1;
-            int row2 = row1 + 1;
+    const double* rowData = m_data->values.constData() + row * m_data->numColumns;
 
-            if ( col1 < 0 )
-                col1 = col2;
-            else if ( col2 >= m_data->numColumns )
-                col2 = col1;
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( !xInterval.contains( x[i] ) )
+        {
+            values[i] = qQNaN();
+            continue;
+        }
 
-            if ( row1 < 0 )
-                row1 = row2;
-            else if ( row2 >= m_data->numRows )
-                row2 = row1;
+        int col = int( ( x[i] - x0 ) / dx );
+        if ( col > maxCol )
+            col = maxCol;
 
-            const double v11 = m_data->value( row1, col1 );
-            const double v21 = m_data->value( row1, col2 );
-            const double v12 = m_data->value( row2, col1 );
-            const double v22 = m_data->value( row2, col2 );
+        values[i] = rowData[col];
+    }
+}
 
-            const double x2 = xInterval.minValue() + ( col2 + 0.5 ) * m_data->dx;
-            const double y2 = yInterval.minValue() + ( row2 + 0.5 ) * m_data->dy;
+/*!
+   \brief Values of a grid of raster positions
+
+   For BilinearInterpolation and BicubicInterpolation the indexes
+   and weights of the contributing matrix cells are calculated once
+   for each column and each row of the grid. Then the grid is
+   resampled separably: first the involved matrix rows are
+   interpolated horizontally, then the grid values vertically.
+   The temporary buffers are kept for each thread and reused
+   for the next call.
+
+   \param x Array of numColumns x values in plot coordinates
+   \param numColumns Number of columns of the grid
+   \param y Array of numRows y values in plot coordinates
+   \param numRows Number of rows of the grid
+   \param values Array for numColumns * numRows values, row by row
+
+   \sa value(), rowValues(), ResampleMode
+ */
+void QwtMatrixRasterData::gridValues( const double* x, int numColumns,
+    const double* y, int numRows, double* values ) const
+{
+    if ( m_data->resampleMode == NearestNeighbour
+        || m_data->numColumns <= 0 || m_data->numRows <= 0 )
+    {
+        QwtRasterData::gridValues( x, numColumns, y, numRows, values );
+        return;
+    }
 
-            const double rx = ( x2 - x ) / m_data->dx;
-            const double ry = ( y2 - y ) / m_data->dy;
+    const QwtInterval xInterval = interval( Qt::XAxis );
+    const QwtInterval yInterval = interval( Qt::YAxis );
 
-            const double vr1 = rx * v11 + ( 1.0 - rx ) * v21;
-            const double vr2 = rx * v12 + ( 1.0 - rx ) * v22;
+    QwtResampleBuffers& buffers = qwtResampleBuffers();
 
-            value = ry * vr1 + ( 1.0 - ry ) * vr2;
+    QVector< QwtResampleTaps >& columnTaps = buffers.columnTaps;
+    columnTaps.resize( numColumns );
 
-            break;
-        }
-        case NearestNeighbour:
-        default:
-        {
-            int row = int( ( y - yInterval.minValue() ) / m_data->dy );
-            int col = int( ( x - xInterval.minValue() ) / m_data->dx );
+    for ( int j = 0; j < numColumns; j++ )
+    {
+        if ( xInterval.contains( x[j] ) )
+            m_data->columnTaps( x[j], columnTaps[j] );
+        else
+            columnTaps[j].index[0] = -1;
+    }
 
-            // In case of intervals, where the maximum is included
-            // we get out of bound for row/col, when the value for the
-            // maximum is requested. Instead we return the value
-            // from the last row/col
+    QVector< QwtResampleTaps >& rowTaps = buffers.rowTaps;
+    rowTaps.resize( numRows );
 
-            if ( row >= m_data->numRows )
-                row = m_data->numRows - 1;
+    for ( int i = 0; i < numRows; i++ )
+    {
+        if ( yInterval.contains( y[i] ) )
+            m_data->rowTaps( y[i], rowTaps[i] );
+        else
+            rowTaps[i].index[0] = -1;
+    }
 
-            if ( col >= m_data->numColumns )
-                col = m_data->numColumns - 1;
+    const double* matrix = m_data->values.constData();
 
-            value = m_data->value( row, col );
-        }
+    if ( m_data->resampleMode == BicubicInterpolation )
+    {
+        qwtResampleGrid< 4 >( matrix, m_data->numColumns, buffers, values );
+    }
+    else
+    {
+        qwtResampleGrid< 2 >( matrix, m_data->numColumns, buffers, values );
     }
-
-    return value;
 }
 
 void QwtMatrixRasterData::update()
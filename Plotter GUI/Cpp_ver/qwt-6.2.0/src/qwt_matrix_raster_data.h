@@ -74,6 +74,12 @@ class QWT_EXPORT QwtMatrixRasterData : public QwtRasterData
 
     virtual double value( double x, double y ) const QWT_OVERRIDE;
 
+    virtual void rowValues( const double* x, double y,
+        double* values, int count ) const QWT_OVERRIDE;
+
+    virtual void gridValues( const double* x, int numColumns,
+        const double* y, int numRows, double* values ) const QWT_OVERRIDE;
+
   private:
     void update();
 
@@ -94,6 +94,7 @@ class QwtPlot::PrivateData
     QwtPlotLayout* layout;
 
     bool autoReplot;
+    QwtPlot::ItemFilter itemFilter;
 };
 
 /*!
@@ -138,6 +139,7 @@ void QwtPlot::initPlot( const QwtText& title )
 
     m_data->layout = new QwtPlotLayout;
     m_data->autoReplot = false;
+    m_data->itemFilter = QwtPlot::AllItems;
 
     // title
     m_data->titleLabel = new QwtTextLabel( this );
@@ -755,10 +757,16 @@ void QwtPlot::drawCanvas( QPainter* painter )
    \param canvasRect Bounding rectangle where to paint
    \param maps QwtAxis::AxisCount maps, mapping between plot and paint device coordinates
 
+   Items with the QwtPlotItem::Retained attribute are composed from
+   an image, that is rendered again only, when the item has been changed.
+   Items not matching the itemFilter() are skipped.
+
    \note Usually canvasRect is contentsRect() of the plot canvas.
         Due to a bug in Qt this rectangle might be wrong for certain
         frame styles ( f.e QFrame::Box ) and it might be necessary to
         fix the margins manually using QWidget::setContentsMargins()
+
+   \sa QwtPlotItem::drawRetained()
  */
 
 void QwtPlot::drawItems( QPainter* painter, const QRectF& canvasRect,
@@ -771,6 +779,15 @@ void QwtPlot::drawItems( QPainter* painter, const QRectF& canvasRect,
         QwtPlotItem* item = *it;
         if ( item && item->isVisible() )
         {
+            if ( m_data->itemFilter != AllItems )
+            {
+                const bool isDynamic =
+                    item->testItemAttribute( QwtPlotItem::Dynamic );
+
+                if ( isDynamic != ( m_data->itemFilter == DynamicItems ) )
+                    continue;
+            }
+
             const QwtAxisId xAxis = item->xAxis();
             const QwtAxisId yAxis = item->yAxis();
 
@@ -784,13 +801,40 @@ void QwtPlot::drawItems( QPainter* painter, const QRectF& canvasRect,
                 item->testRenderHint( QwtPlotItem::RenderAntialiased ) );
 #endif
 
-            item->draw( painter, maps[xAxis], maps[yAxis], canvasRect );
+            if ( item->testItemAttribute( QwtPlotItem::Retained ) )
+                item->drawRetained( painter, maps[xAxis], maps[yAxis], canvasRect );
+            else
+                item->draw( painter, maps[xAxis], maps[yAxis], canvasRect );
 
             painter->restore();
         }
     }
 }
 
+/*!
+   \brief Set the filter for the items painted by drawItems()
+
+   The filter is used by QwtPlotCanvas to paint its layers, when
+   QwtPlotCanvas::LayeredBackingStore is enabled. The default
+   setting is AllItems.
+
+   \param filter Item filter
+   \sa itemFilter(), QwtPlotItem::Dynamic
+ */
+void QwtPlot::setItemFilter( ItemFilter filter )
+{
+    m_data->itemFilter = filter;
+}
+
+/*!
+   \return Filter for the items painted by drawItems()
+   \sa setItemFilter()
+ */
+QwtPlot::ItemFilter QwtPlot::itemFilter() const
+{
+    return m_data->itemFilter;
+}
+
 /*!
    \param axisId Axis
    \return Map for the axis on the canvas. With this map pixel coordinates can
@@ -105,6 +105,23 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
         TopLegend
     };
 
+    /*!
+        Items being painted by drawItems()
+
+        \sa setItemFilter(), QwtPlotItem::Dynamic
+     */
+    enum ItemFilter
+    {
+        //! All visible items
+        AllItems,
+
+        //! Visible items without the QwtPlotItem::Dynamic attribute
+        StaticItems,
+
+        //! Visible items with the QwtPlotItem::Dynamic attribute
+        DynamicItems
+    };
+
     explicit QwtPlot( QWidget* = NULL );
     explicit QwtPlot( const QwtText& title, QWidget* = NULL );
 
@@ -231,6 +248,9 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     virtual void drawItems( QPainter*, const QRectF&,
         const QwtScaleMap maps[ QwtAxis::AxisPositions ] ) const;
 
+    void setItemFilter( ItemFilter );
+    ItemFilter itemFilter() const;
+
     virtual QVariant itemToInfo( QwtPlotItem* ) const;
     virtual QwtPlotItem* infoToItem( const QVariant& ) const;
 
@@ -298,6 +318,8 @@ class QWT_EXPORT QwtPlot : public QFrame, public QwtPlotDict
     void deleteAxesData();
     void updateScaleDiv();
 
+    bool isUpdatingScaleDivs() const;
+
     void initPlot( const QwtText& title );
 
     class ScaleData;
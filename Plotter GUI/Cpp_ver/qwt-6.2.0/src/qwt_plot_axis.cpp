@@ -8,6 +8,7 @@
  *****************************************************************************/
 
 #include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
 #include "qwt_scale_widget.h"
 #include "qwt_scale_map.h"
 #include "qwt_scale_div.h"
@@ -81,6 +82,7 @@ class QwtPlot::ScaleData
 {
   public:
     ScaleData( QwtPlot* plot )
+        : isUpdatingScaleDivs( false )
     {
         using namespace QwtAxis;
 
@@ -100,6 +102,9 @@ class QwtPlot::ScaleData
         return m_axisData[ axisId ];
     }
 
+    // items are notified about new scale divisions by updateAxes()
+    bool isUpdatingScaleDivs;
+
   private:
     AxisData m_axisData[ QwtAxis::AxisPositions ];
 };
@@ -697,6 +702,8 @@ void QwtPlot::updateAxes()
 
     // Adjust scales
 
+    bool isRedivided = false;
+
     for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
     {
         {
@@ -704,6 +711,8 @@ void QwtPlot::updateAxes()
 
             AxisData& d = m_scaleData->axisData( axisId );
 
+            const QwtScaleDiv oldScaleDiv = d.scaleDiv;
+
             double minValue = d.minValue;
             double maxValue = d.maxValue;
             double stepSize = d.stepSize;
@@ -727,6 +736,12 @@ void QwtPlot::updateAxes()
                 d.isValid = true;
             }
 
+            if ( d.scaleDiv != oldScaleDiv
+                && d.scaleDiv.interval() == oldScaleDiv.interval() )
+            {
+                isRedivided = true;
+            }
+
             QwtScaleWidget* scaleWidget = axisWidget( axisId );
             scaleWidget->setScaleDiv( d.scaleDiv );
 
@@ -736,6 +751,18 @@ void QwtPlot::updateAxes()
         }
     }
 
+    /*
+        Changing the scale divisions of the items ( f.e. the grid )
+        does not invalidate the backing store of a QwtPlotCanvas with
+        LayeredBackingStore or ScrollBackingStore: it is rendered again
+        or scrolled, when the maps have been changed.
+        Only when the ticks have been changed for the same intervals
+        the maps are unchanged and the backing store has to be
+        invalidated here.
+     */
+
+    m_scaleData->isUpdatingScaleDivs = true;
+
     for ( it = itmList.begin(); it != itmList.end(); ++it )
     {
         QwtPlotItem* item = *it;
@@ -745,5 +772,22 @@ void QwtPlot::updateAxes()
                 axisScaleDiv( item->yAxis() ) );
         }
     }
+
+    m_scaleData->isUpdatingScaleDivs = false;
+
+    if ( isRedivided )
+    {
+        QwtPlotCanvas* plotCanvas = qobject_cast< QwtPlotCanvas* >( canvas() );
+        if ( plotCanvas )
+            plotCanvas->invalidateBackingStore();
+    }
+}
+
+/*
+   \return True, while updateAxes() passes the scale divisions to the items
+ */
+bool QwtPlot::isUpdatingScaleDivs() const
+{
+    return m_scaleData->isUpdatingScaleDivs;
 }
 
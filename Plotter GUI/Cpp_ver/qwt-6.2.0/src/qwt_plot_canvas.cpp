@@ -10,11 +10,162 @@
 #include "qwt_plot_canvas.h"
 #include "qwt_painter.h"
 #include "qwt_plot.h"
+#include "qwt_plot_marker.h"
+#include "qwt_scale_map.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qevent.h>
 
+static bool qwtIsSameMaps( const QwtScaleMap* maps1, const QwtScaleMap* maps2 )
+{
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        if ( !maps1[axisPos].isSameMapping( maps2[axisPos] ) )
+            return false;
+    }
+
+    return true;
+}
+
+/*
+   Items, that are painted at a fixed position of the canvas,
+   would be smeared, when scrolling the backing store.
+ */
+static bool qwtIsCanvasAnchored( const QwtPlotItem* item )
+{
+    switch ( item->rtti() )
+    {
+        case QwtPlotItem::Rtti_PlotTextLabel:
+        case QwtPlotItem::Rtti_PlotLegend:
+        case QwtPlotItem::Rtti_PlotScale:
+        {
+            return true;
+        }
+        case QwtPlotItem::Rtti_PlotMarker:
+        {
+            // the label of a horizontal line is aligned to the canvas
+
+            const QwtPlotMarker* marker = static_cast< const QwtPlotMarker* >( item );
+            return ( marker->lineStyle() == QwtPlotMarker::HLine )
+                && !marker->label().isEmpty();
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+   Find the horizontal shift in pixels between the old and the new maps
+   of the axes, that are used by visible items. The y maps have to be
+   the same, while all x maps have to be shifted by the same integer
+   number of pixels. Visible items in the backing store, that are
+   anchored to the canvas, prevent scrolling.
+ */
+static bool qwtScrollDelta( const QwtPlot* plot,
+    const QwtScaleMap* oldMaps, const QwtScaleMap* maps, int& dx )
+{
+    const double tolerance = 1e-3;
+
+    bool isUsed[ QwtAxis::AxisPositions ] = { false };
+
+    const QwtPlotItemList& items = plot->itemList();
+    for ( QwtPlotItemIterator it = items.begin(); it != items.end(); ++it )
+    {
+        const QwtPlotItem* item = *it;
+
+        // dynamic items of a LayeredBackingStore are not scrolled
+        if ( plot->itemFilter() == QwtPlot::StaticItems
+            && item->testItemAttribute( QwtPlotItem::Dynamic ) )
+        {
+            continue;
+        }
+
+        if ( item->isVisible() )
+        {
+            if ( qwtIsCanvasAnchored( item ) )
+                return false;
+
+            isUsed[ item->xAxis() ] = true;
+            isUsed[ item->yAxis() ] = true;
+        }
+    }
+
+    bool hasDelta = false;
+    double delta = 0.0;
+
+    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+    {
+        if ( !isUsed[axisPos] )
+            continue;
+
+        const QwtScaleMap& map1 = oldMaps[axisPos];
+        const QwtScaleMap& map2 = maps[axisPos];
+
+        if ( QwtAxis::isYAxis( axisPos ) )
+        {
+            if ( !map1.isSameMapping( map2 ) )
+                return false;
+
+            continue;
+        }
+
+        if ( map1.p1() != map2.p1() || map1.p2() != map2.p2() )
+            return false;
+
+        // all values have to be shifted by the same number of pixels
+
+        const double s = 0.5 * ( map1.s1() + map1.s2() );
+
+        const double d1 = map2.transform( map1.s1() ) - map1.p1();
+        const double d2 = map2.transform( map1.s2() ) - map1.p2();
+        const double d = map2.transform( s ) - map1.transform( s );
+
+        if ( !( qAbs( d1 - d2 ) < tolerance && qAbs( d1 - d ) < tolerance ) )
+            return false;
+
+        if ( hasDelta && !( qAbs( d1 - delta ) < tolerance ) )
+            return false;
+
+        delta = d1;
+        hasDelta = true;
+    }
+
+    if ( !hasDelta )
+        return false;
+
+    dx = qRound( delta );
+    return qAbs( delta - dx ) < tolerance;
+}
+
+namespace
+{
+    // setting an item filter for the lifetime of the object
+    class QwtItemFilterScope
+    {
+      public:
+        QwtItemFilterScope( QwtPlot* plot, QwtPlot::ItemFilter filter )
+            : m_plot( plot )
+        {
+            if ( m_plot )
+            {
+                m_filter = m_plot->itemFilter();
+                m_plot->setItemFilter( filter );
+            }
+        }
+
+        ~QwtItemFilterScope()
+        {
+            if ( m_plot )
+                m_plot->setItemFilter( m_filter );
+        }
+
+      private:
+        QwtPlot* m_plot;
+        QwtPlot::ItemFilter m_filter;
+    };
+}
+
 class QwtPlotCanvas::PrivateData
 {
   public:
@@ -30,6 +181,9 @@ class QwtPlotCanvas::PrivateData
 
     QwtPlotCanvas::PaintAttributes paintAttributes;
     QPixmap* backingStore;
+
+    // the maps used for the content of the backing store
+    QwtScaleMap maps[ QwtAxis::AxisPositions ];
 };
 
 /*!
@@ -110,6 +264,12 @@ void QwtPlotCanvas::setPaintAttribute( PaintAttribute attribute, bool on )
 
             break;
         }
+        case LayeredBackingStore:
+        case ScrollBackingStore:
+        {
+            invalidateBackingStore();
+            break;
+        }
         default:
         {
             break;
@@ -168,6 +328,16 @@ bool QwtPlotCanvas::event( QEvent* event )
         updateStyleSheetInfo();
     }
 
+    if ( event->type() == QEvent::StyleChange ||
+        event->type() == QEvent::PaletteChange )
+    {
+        if ( testPaintAttribute( LayeredBackingStore )
+            || testPaintAttribute( ScrollBackingStore ) )
+        {
+            invalidateBackingStore();
+        }
+    }
+
     return QFrame::event( event );
 }
 
@@ -183,9 +353,49 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
     if ( testPaintAttribute( QwtPlotCanvas::BackingStore ) &&
         m_data->backingStore != NULL )
     {
+        QwtPlot* plot = qobject_cast< QwtPlot* >( parent() );
+
+        const bool isLayered = plot && testPaintAttribute( LayeredBackingStore );
+        const bool doScroll = plot && testPaintAttribute( ScrollBackingStore );
+
         QPixmap& bs = *m_data->backingStore;
+
+        if ( ( isLayered || doScroll ) && !bs.isNull() )
+        {
+            QwtScaleMap maps[ QwtAxis::AxisPositions ];
+            for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+                maps[axisPos] = plot->canvasMap( axisPos );
+
+            if ( !qwtIsSameMaps( m_data->maps, maps ) )
+            {
+                const QwtItemFilterScope filterScope(
+                    isLayered ? plot : NULL, QwtPlot::StaticItems );
+
+                int dx = 0;
+                if ( doScroll && qwtScrollDelta( plot, m_data->maps, maps, dx )
+                    && scrollBackingStore( dx ) )
+                {
+                    for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+                        m_data->maps[axisPos] = maps[axisPos];
+                }
+                else
+                {
+                    bs = QPixmap();
+                }
+            }
+        }
+
         if ( bs.size() != size() * QwtPainter::devicePixelRatio( &bs ) )
         {
+            const QwtItemFilterScope filterScope(
+                isLayered ? plot : NULL, QwtPlot::StaticItems );
+
+            if ( plot )
+            {
+                for ( int axisPos = 0; axisPos < QwtAxis::AxisPositions; axisPos++ )
+                    m_data->maps[axisPos] = plot->canvasMap( axisPos );
+            }
+
             bs = QwtPainter::backingStore( this, size() );
 
             if ( testAttribute(Qt::WA_StyledBackground) )
@@ -214,6 +424,12 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
         }
 
         painter.drawPixmap( 0, 0, *m_data->backingStore );
+
+        if ( isLayered )
+        {
+            const QwtItemFilterScope filterScope( plot, QwtPlot::DynamicItems );
+            drawCanvas( &painter );
+        }
     }
     else
     {
@@ -267,6 +483,53 @@ void QwtPlotCanvas::paintEvent( QPaintEvent* event )
         drawFocusIndicator( &painter );
 }
 
+/*
+   Shift the content of the backing store and render the exposed
+   strip. Returns false, when the backing store can't be scrolled.
+ */
+bool QwtPlotCanvas::scrollBackingStore( int dx )
+{
+    if ( testAttribute( Qt::WA_StyledBackground ) || borderRadius() > 0.0 )
+        return false;
+
+    const QBrush brush = palette().brush( backgroundRole() );
+    if ( brush.style() != Qt::SolidPattern )
+        return false;
+
+    const QRect cr = contentsRect();
+    if ( qAbs( dx ) >= cr.width() )
+        return false;
+
+    QPixmap& bs = *m_data->backingStore;
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( &bs );
+
+    const double dxDevice = dx * pixelRatio;
+    if ( dxDevice != qRound( dxDevice ) )
+        return false;
+
+    if ( dx != 0 )
+    {
+        const QRect deviceRect( cr.topLeft() * pixelRatio, cr.size() * pixelRatio );
+
+        bs.scroll( qRound( dxDevice ), 0, deviceRect );
+
+        QRect strip = cr;
+        if ( dx > 0 )
+            strip.setWidth( dx );
+        else
+            strip.setLeft( cr.right() + 1 + dx );
+
+        QPainter painter( &bs );
+        painter.setClipRect( strip );
+        painter.fillRect( strip, brush );
+
+        drawCanvas( &painter );
+    }
+
+    return true;
+}
+
 /*!
    Draw the border of the plot canvas
 
@@ -296,11 +559,20 @@ void QwtPlotCanvas::resizeEvent( QResizeEvent* event )
 
 /*!
    Invalidate the paint cache and repaint the canvas
+
+   With LayeredBackingStore the backing store is kept, when
+   only dynamic items have been changed. With ScrollBackingStore
+   it is scrolled, when the x maps have been shifted.
+
    \sa invalidatePaintCache()
  */
 void QwtPlotCanvas::replot()
 {
-    invalidateBackingStore();
+    if ( !( testPaintAttribute( LayeredBackingStore )
+        || testPaintAttribute( ScrollBackingStore ) ) )
+    {
+        invalidateBackingStore();
+    }
 
     if ( testPaintAttribute( QwtPlotCanvas::ImmediatePaint ) )
         repaint( contentsRect() );
@@ -96,7 +96,67 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
 
            \sa replot(), QWidget::repaint(), QWidget::update()
          */
-        ImmediatePaint = 8
+        ImmediatePaint = 8,
+
+        /*!
+           \brief Split the backing store into a static and a dynamic layer
+
+           The backing store contains the background, the border and
+           all items without the QwtPlotItem::Dynamic attribute. Dynamic
+           items are painted on top of it for each paint event.
+
+           replot() keeps the backing store as long as no static item
+           has been changed, attached or detached and the scale maps
+           of the canvas are the same. So updating a couple of live
+           curves doesn't render the static items again.
+
+           Overlays like rubber bands or trackers are separate widgets
+           ( QwtWidgetOverlay ), that are composed on top by Qt.
+
+           \note Has no effect without BackingStore
+           \sa QwtPlot::setItemFilter(), invalidateBackingStore()
+         */
+        LayeredBackingStore = 16,
+
+        /*!
+           \brief Scroll the backing store, when the x scales are shifted
+
+           When replot() is called for a plot, where the x maps of all
+           visible items have been shifted by the same number of pixels,
+           while the y maps are unchanged, the content of the backing store
+           is scrolled and only the exposed strip is rendered. The axes
+           are separate widgets, that are updated by Qt.
+
+           This is useful for scrolling time windows, where the interval
+           is shifted by multiples of the width of a pixel. Other changes
+           of the scales render the complete backing store.
+
+           Like with LayeredBackingStore changing, attaching or detaching
+           an item invalidates the backing store. Together with LayeredBackingStore
+           only the static layer is scrolled. New scale divisions, that are
+           passed to items like QwtPlotGrid by QwtPlot::updateAxes(), don't
+           invalidate the backing store, when the ticks are shifted with the maps.
+
+           So for constant costs of a scrolling plot, items that are changed
+           for each replot ( f.e. a curve with appended samples ) need to be
+           QwtPlotItem::Dynamic together with LayeredBackingStore. Otherwise
+           each change of such an item renders the complete backing store.
+
+           Items, that are painted at a fixed position of the canvas,
+           would be smeared by scrolling. So the complete backing store
+           is rendered, when a visible QwtPlotTextLabel, QwtPlotLegendItem,
+           QwtPlotScaleItem or a QwtPlotMarker with a label for a
+           horizontal line is attached - unless it is a QwtPlotItem::Dynamic
+           item of a LayeredBackingStore. Items of derived classes
+           ( Rtti_PlotUserItem ) are expected to be painted in scale
+           coordinates.
+
+           \note Has no effect without BackingStore and is limited to canvases
+                 with a solid background and without rounded borders
+                 or style sheets.
+           \sa replot(), invalidateBackingStore()
+         */
+        ScrollBackingStore = 32
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -124,6 +184,8 @@ class QWT_EXPORT QwtPlotCanvas : public QFrame, public QwtPlotAbstractCanvas
     virtual void drawBorder( QPainter* ) QWT_OVERRIDE;
 
   private:
+    bool scrollBackingStore( int dx );
+
     class PrivateData;
     PrivateData* m_data;
 };
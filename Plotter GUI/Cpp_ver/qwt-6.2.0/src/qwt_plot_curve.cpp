@@ -17,11 +17,13 @@
 #include "qwt_spline_curve_fitter.h"
 #include "qwt_symbol.h"
 #include "qwt_point_mapper.h"
+#include "qwt_line_rasterizer.h"
 #include "qwt_text.h"
 #include "qwt_graphic.h"
 
 #include <qpainter.h>
 #include <qpainterpath.h>
+#include <qpaintengine.h>
 
 static inline QRectF qwtIntersectedClipRect( const QRectF& rect, QPainter* painter )
 {
@@ -32,6 +34,56 @@ static inline QRectF qwtIntersectedClipRect( const QRectF& rect, QPainter* paint
     return clipRect;
 }
 
+static void qwtDrawClippedPolyline( QPainter* painter,
+    const QRectF& clipRect, QPolygonF& polyline )
+{
+    if ( painter->pen().style() != Qt::SolidLine )
+    {
+        // splitting would restart the dash pattern for each part
+        QwtClipper::clipPolygonF( clipRect, polyline, false );
+        QwtPainter::drawPolyline( painter, polyline );
+
+        return;
+    }
+
+    /*
+        Instead of following the border of the clip rectangle
+        each excursion outside ends a part of the polyline
+     */
+    const QVector< QPolygonF > parts =
+        QwtClipper::splitPolylineF( clipRect, polyline );
+
+    for ( int i = 0; i < parts.size(); i++ )
+        QwtPainter::drawPolyline( painter, parts[i] );
+}
+
+static void qwtRasterizePolyline( QPainter* painter,
+    const QPolygonF& polyline, uint numThreads )
+{
+    QwtLineRasterizer rasterizer;
+    rasterizer.setThreadCount( numThreads );
+
+    if ( !rasterizer.drawPolyline( painter, polyline.constData(), polyline.size() ) )
+        QwtPainter::drawPolyline( painter, polyline );
+}
+
+/*
+   The images of LinesImageBuffer have the resolution of the canvas
+   in logical coordinates. They are not used, when they would be
+   scaled or embedded into a vector format.
+ */
+static bool qwtUseLinesImageBuffer( const QPainter* painter )
+{
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::Raster )
+        return false;
+
+    if ( painter->transform().type() > QTransform::TxTranslate )
+        return false;
+
+    return QwtPainter::devicePixelRatio( painter->device() ) == 1.0;
+}
+
 static void qwtUpdateLegendIconSize( QwtPlotCurve* curve )
 {
     if ( curve->symbol() &&
@@ -69,6 +121,111 @@ static int qwtVerifyRange( int size, int& i1, int& i2 )
     return ( i2 - i1 + 1 );
 }
 
+// index of the first sample in [from, to] with x >= value, or to + 1
+static int qwtLowerIndexX( const QwtSeriesData< QPointF >* series,
+    int from, int to, double value )
+{
+    int n = to - from + 1;
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int indexMid = from + half;
+
+        if ( series->sample( indexMid ).x() < value )
+        {
+            from = indexMid + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    return from;
+}
+
+// index of the first sample in [from, to] with x > value, or to + 1
+static int qwtUpperIndexX( const QwtSeriesData< QPointF >* series,
+    int from, int to, double value )
+{
+    int n = to - from + 1;
+    while ( n > 0 )
+    {
+        const int half = n >> 1;
+        const int indexMid = from + half;
+
+        if ( series->sample( indexMid ).x() <= value )
+        {
+            from = indexMid + 1;
+            n -= half + 1;
+        }
+        else
+        {
+            n = half;
+        }
+    }
+
+    return from;
+}
+
+static inline bool qwtUpdateClosest( const QwtScaleMap& xMap,
+    const QwtScaleMap& yMap, const QPointF& sample, const QPointF& pos,
+    double& dx2, double& dmin )
+{
+    const QPointF p = QwtScaleMap::transform( xMap, yMap, sample );
+
+    dx2 = qwtSqr( p.x() - pos.x() );
+
+    const double f = dx2 + qwtSqr( p.y() - pos.y() );
+    if ( f < dmin )
+    {
+        dmin = f;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+    For samples sorted in x direction the distance in x direction
+    is growing, when walking away from the position in both directions.
+    As it is a lower limit for the distance we can stop, when
+    it exceeds the distance of the closest point found so far.
+ */
+static int qwtClosestPointSortedX( const QwtSeriesData< QPointF >* series,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QPointF& pos, double& dmin )
+{
+    const int numSamples = static_cast< int >( series->size() );
+
+    const int index0 = qwtLowerIndexX( series,
+        0, numSamples - 1, xMap.invTransform( pos.x() ) );
+
+    int index = -1;
+    double dx2;
+
+    for ( int i = index0; i < numSamples; i++ )
+    {
+        if ( qwtUpdateClosest( xMap, yMap, series->sample( i ), pos, dx2, dmin ) )
+            index = i;
+
+        if ( dx2 >= dmin )
+            break;
+    }
+
+    for ( int i = index0 - 1; i >= 0; i-- )
+    {
+        if ( qwtUpdateClosest( xMap, yMap, series->sample( i ), pos, dx2, dmin ) )
+            index = i;
+
+        if ( dx2 >= dmin )
+            break;
+    }
+
+    return index;
+}
+
 class QwtPlotCurve::PrivateData
 {
   public:
@@ -392,6 +549,31 @@ void QwtPlotCurve::drawSeries( QPainter* painter,
 
     if ( qwtVerifyRange( numSamples, from, to ) > 0 )
     {
+        if ( m_data->attributes & SortedX )
+        {
+            /*
+               Skipping the samples outside of the visible x interval
+               beside the first one on each side, so that the lines
+               to the neighbored samples are not lost.
+             */
+            double margin = 0.0;
+            if ( m_data->symbol &&
+                ( m_data->symbol->style() != QwtSymbol::NoSymbol ) )
+            {
+                margin = m_data->symbol->boundingRect().width();
+            }
+
+            double x1 = xMap.invTransform( canvasRect.left() - margin );
+            double x2 = xMap.invTransform( canvasRect.right() + margin );
+            if ( x1 > x2 )
+                qSwap( x1, x2 );
+
+            const QwtSeriesData< QPointF >* series = data();
+
+            from = qMax( from, qwtLowerIndexX( series, from, to, x1 ) - 1 );
+            to = qMin( to, qwtUpperIndexX( series, from, to, x2 ) );
+        }
+
         painter->save();
         painter->setPen( m_data->pen );
 
@@ -484,6 +666,8 @@ void QwtPlotCurve::drawLines( QPainter* painter,
     const bool doAlign = !doFit && QwtPainter::roundingAlignment( painter );
     const bool doFill = ( m_data->brush.style() != Qt::NoBrush )
         && ( m_data->brush.color().alpha() > 0 );
+    const bool doRasterize = ( m_data->paintAttributes & RasterizeLines )
+        && QwtLineRasterizer::isSupported( painter );
 
     QRectF clipRect;
     if ( m_data->paintAttributes & ClipPolygons )
@@ -507,7 +691,23 @@ void QwtPlotCurve::drawLines( QPainter* painter,
         testPaintAttribute( FilterPoints ) ||
         testPaintAttribute( FilterPointsAggressive ) );
 
+    if ( !doFit && testPaintAttribute( MinMaxColumns ) )
+        mapper.setFlag( QwtPointMapper::MinMaxColumns, true );
+
     mapper.setBoundingRect( canvasRect );
+    mapper.setThreadCount( renderThreadCount() );
+
+    if ( ( m_data->paintAttributes & LinesImageBuffer ) && !doFit && !doFill
+        && qwtUseLinesImageBuffer( painter ) )
+    {
+        const QImage image = mapper.toPolylineImage( xMap, yMap,
+            data(), from, to, painter->pen(),
+            painter->testRenderHint( QPainter::Antialiasing ),
+            renderThreadCount() );
+
+        painter->drawImage( canvasRect.toAlignedRect(), image );
+        return;
+    }
 
     QPolygonF polyline = mapper.toPolygonF( xMap, yMap, data(), from, to );
 
@@ -531,10 +731,12 @@ void QwtPlotCurve::drawLines( QPainter* painter,
             fillCurve( painter, xMap, yMap, canvasRect, filled );
             filled.clear();
 
-            if ( m_data->paintAttributes & ClipPolygons )
-                QwtClipper::clipPolygonF( clipRect, polyline, false );
-
-            QwtPainter::drawPolyline( painter, polyline );
+            if ( doRasterize )
+                qwtRasterizePolyline( painter, polyline, renderThreadCount() );
+            else if ( m_data->paintAttributes & ClipPolygons )
+                qwtDrawClippedPolyline( painter, clipRect, polyline );
+            else
+                QwtPainter::drawPolyline( painter, polyline );
         }
         else
         {
@@ -543,8 +745,21 @@ void QwtPlotCurve::drawLines( QPainter* painter,
     }
     else
     {
+        if ( doRasterize && !doFit )
+        {
+            // the rasterizer does its own clipping
+            qwtRasterizePolyline( painter, polyline, renderThreadCount() );
+            return;
+        }
+
         if ( testPaintAttribute( ClipPolygons ) )
         {
+            if ( !doFit )
+            {
+                qwtDrawClippedPolyline( painter, clipRect, polyline );
+                return;
+            }
+
             QwtClipper::clipPolygonF( clipRect, polyline, false );
         }
 
@@ -560,7 +775,11 @@ void QwtPlotCurve::drawLines( QPainter* painter,
             else
             {
                 polyline = m_data->curveFitter->fitCurve( polyline );
-                QwtPainter::drawPolyline( painter, polyline );
+
+                if ( doRasterize )
+                    qwtRasterizePolyline( painter, polyline, renderThreadCount() );
+                else
+                    QwtPainter::drawPolyline( painter, polyline );
             }
         }
         else
@@ -744,13 +963,29 @@ void QwtPlotCurve::drawSteps( QPainter* painter,
 {
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    QPolygonF polygon( 2 * ( to - from ) + 1 );
-    QPointF* points = polygon.data();
-
     bool inverted = orientation() == Qt::Vertical;
     if ( m_data->attributes & Inverted )
         inverted = !inverted;
 
+    if ( ( m_data->paintAttributes & LinesImageBuffer )
+        && m_data->brush.style() == Qt::NoBrush && qwtUseLinesImageBuffer( painter ) )
+    {
+        QwtPointMapper mapper;
+        mapper.setBoundingRect( canvasRect );
+        mapper.setFlag( QwtPointMapper::RoundPoints, doAlign );
+
+        const QImage image = mapper.toStepsImage( xMap, yMap,
+            data(), from, to, inverted, painter->pen(),
+            painter->testRenderHint( QPainter::Antialiasing ),
+            renderThreadCount() );
+
+        painter->drawImage( canvasRect.toAlignedRect(), image );
+        return;
+    }
+
+    QPolygonF polygon( 2 * ( to - from ) + 1 );
+    QPointF* points = polygon.data();
+
     const QwtSeriesData< QPointF >* series = data();
 
     int i, ip;
@@ -1045,8 +1280,8 @@ double QwtPlotCurve::baseline() const
               the position and the closest curve point
    \return Index of the closest curve point, or -1 if none can be found
           ( f.e when the curve has no points )
-   \note closestPoint() implements a dumb algorithm, that iterates
-        over all points
+   \note Unless the SortedX attribute is set closestPoint() implements
+         a dumb algorithm, that iterates over all points
  */
 int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
 {
@@ -1063,18 +1298,41 @@ int QwtPlotCurve::closestPoint( const QPointF& pos, double* dist ) const
     int index = -1;
     double dmin = 1.0e10;
 
-    for ( uint i = 0; i < numSamples; i++ )
+    if ( m_data->attributes & SortedX )
     {
-        const QPointF sample = series->sample( i );
+        index = qwtClosestPointSortedX( series, xMap, yMap, pos, dmin );
+        if ( dist )
+            *dist = std::sqrt( dmin );
+
+        return index;
+    }
+
+    QVector< QPointF > points;
 
-        const double cx = xMap.transform( sample.x() ) - pos.x();
-        const double cy = yMap.transform( sample.y() ) - pos.y();
+    QwtSeriesBlockReader< QPointF > reader( series, 0, numSamples - 1 );
+    while ( reader.next() )
+    {
+        const int count = reader.count();
+
+        if ( points.size() < count )
+            points.resize( count );
+
+        QwtScaleMap::transform( xMap, yMap,
+            reader.samples(), points.data(), count );
+
+        const QPointF* mapped = points.constData();
 
-        const double f = qwtSqr( cx ) + qwtSqr( cy );
-        if ( f < dmin )
+        for ( int i = 0; i < count; i++ )
         {
-            index = i;
-            dmin = f;
+            const double cx = mapped[i].x() - pos.x();
+            const double cy = mapped[i].y() - pos.y();
+
+            const double f = qwtSqr( cx ) + qwtSqr( cy );
+            if ( f < dmin )
+            {
+                index = reader.index() + i;
+                dmin = f;
+            }
         }
     }
     if ( dist )
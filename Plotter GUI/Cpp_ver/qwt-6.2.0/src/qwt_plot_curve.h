@@ -127,7 +127,19 @@ class QWT_EXPORT QwtPlotCurve
            If painting in QwtPlotCurve::Fitted mode is slow it might be better
            to fit the points, before they are passed to QwtPlotCurve.
          */
-        Fitted = 0x02
+        Fitted = 0x02,
+
+        /*!
+           The samples are sorted in increasing order of their x coordinates,
+           like it is the case for most time series.
+
+           Then drawSeries() paints only the samples inside the visible
+           x interval, that can be found by a binary search, and closestPoint()
+           checks only the samples in the neighborhood of the position.
+
+           \note The order of the samples is not verified.
+         */
+        SortedX = 0x04
     };
 
     Q_DECLARE_FLAGS( CurveAttributes, CurveAttribute )
@@ -203,6 +215,8 @@ class QWT_EXPORT QwtPlotCurve
            having a huge amount of points.
            With a reasonable number of points QPainter::drawPoints()
            will be faster.
+
+           \sa QwtPointMapper::toImage(), LinesImageBuffer
          */
         ImageBuffer = 0x08,
 
@@ -229,6 +243,60 @@ class QWT_EXPORT QwtPlotCurve
                 worked around by enabling the QwtPainter::polylineSplitting() mode.
          */
         FilterPointsAggressive = 0x10,
+
+        /*!
+           Rasterize the lines with QwtLineRasterizer instead of QPainter,
+           when painter and pen allow it: a solid pen of one pixel
+           width, the raster paint engine, no transformation beside
+           a translation and no clip region beside a rectangle.
+
+           The lines are written directly into the pixels of a QImage
+           paint device and composed from an intermediate image
+           for other paint devices. For huge polylines this is much faster,
+           but the result is not pixel identical to what QPainter renders.
+
+           \note Implemented for QwtPlotCurve::Lines only
+           \sa QwtLineRasterizer, setRenderThreadCount()
+         */
+        RasterizeLines = 0x20,
+
+        /*!
+           An "oscilloscope" mode for dense series with increasing
+           x coordinates: each chunk of consecutive samples, that is
+           mapped to the same pixel column, is reduced to 4 points
+           ( first, min, max, last ) in one linear pass.
+
+           In opposite to FilterPointsAggressive the reduction does not depend
+           on the rounding alignment of the paint device. In the worst case
+           the polygon to be rendered will be 4 times the width of the
+           plot canvas, no matter how many samples are in the series.
+
+           For an opaque, aliased pen of one pixel width the output is identical
+           to drawing all points on paint devices in integer coordinates.
+           With translucent or antialiased pens the overdraw of the original
+           polyline is lost, what results in minor visual differences.
+
+           \note Implemented for QwtPlotCurve::Lines only
+           \note Ignored, when the curve is Fitted
+           \sa QwtPointMapper::MinMaxColumns
+         */
+        MinMaxColumns = 0x40,
+
+        /*!
+           Render Lines and Steps to a temporary image and paint the image.
+           The image is rendered in chunks by several threads
+           ( setRenderThreadCount() ), that are composed afterwards.
+
+           The image has the resolution of the canvas in logical coordinates.
+           So it is ignored, when painting to a paint device with a device
+           pixel ratio != 1, with a painter transformation beside a translation
+           or with a paint engine, that is not QPaintEngine::Raster
+           ( f.e. when printing or exporting to vector formats ). It is also
+           ignored for fitted or filled curves.
+
+           \sa QwtPointMapper::toPolylineImage(), QwtPointMapper::toStepsImage()
+         */
+        LinesImageBuffer = 0x80
     };
 
     Q_DECLARE_FLAGS( PaintAttributes, PaintAttribute )
@@ -39,6 +39,14 @@ static inline bool qwtHasBackingStore( const QwtPlotCanvas* canvas )
            && canvas->backingStore() && !canvas->backingStore()->isNull();
 }
 
+// dynamic items are not part of a layered backing store
+static inline bool qwtIsDynamicLayer(
+    const QwtPlotCanvas* canvas, const QwtPlotItem* item )
+{
+    return canvas->testPaintAttribute( QwtPlotCanvas::LayeredBackingStore )
+           && item->testItemAttribute( QwtPlotItem::Dynamic );
+}
+
 class QwtPlotDirectPainter::PrivateData
 {
   public:
@@ -180,7 +188,8 @@ void QwtPlotDirectPainter::drawSeries(
 
     QwtPlotCanvas* plotCanvas = qobject_cast< QwtPlotCanvas* >( canvas );
 
-    if ( plotCanvas && qwtHasBackingStore( plotCanvas ) )
+    if ( plotCanvas && qwtHasBackingStore( plotCanvas )
+        && !qwtIsDynamicLayer( plotCanvas, seriesItem ) )
     {
         QPainter painter( const_cast< QPixmap* >( plotCanvas->backingStore() ) );
 
@@ -302,6 +311,9 @@ bool QwtPlotDirectPainter::eventFilter( QObject*, QEvent* event )
                     {
                         painter.drawPixmap( plotCanvas->rect().topLeft(),
                             *plotCanvas->backingStore() );
+
+                        if ( qwtIsDynamicLayer( plotCanvas, m_data->seriesItem ) )
+                            doCopyCache = false;
                     }
                 }
             }
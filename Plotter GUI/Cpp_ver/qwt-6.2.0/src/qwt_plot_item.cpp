@@ -10,11 +10,57 @@
 #include "qwt_plot_item.h"
 #include "qwt_text.h"
 #include "qwt_plot.h"
+#include "qwt_plot_canvas.h"
 #include "qwt_legend_data.h"
 #include "qwt_scale_map.h"
 #include "qwt_graphic.h"
+#include "qwt_painter.h"
 
 #include <qpainter.h>
+#include <qimage.h>
+
+static inline void qwtInvalidateBackingStore( QwtPlot* plot, bool isDynamic )
+{
+    QwtPlotCanvas* canvas = qobject_cast< QwtPlotCanvas* >( plot->canvas() );
+    if ( canvas == NULL )
+        return;
+
+    const bool isLayered =
+        canvas->testPaintAttribute( QwtPlotCanvas::LayeredBackingStore );
+
+    // otherwise the backing store is invalidated by QwtPlotCanvas::replot()
+    if ( !( isLayered
+        || canvas->testPaintAttribute( QwtPlotCanvas::ScrollBackingStore ) ) )
+    {
+        return;
+    }
+
+    // dynamic items are not part of a layered backing store
+    if ( isDynamic && isLayered )
+        return;
+
+    // the canvas compares the maps, when the scale divisions have been changed
+    if ( plot->isUpdatingScaleDivs() )
+        return;
+
+    canvas->invalidateBackingStore();
+}
+
+static inline bool qwtCanRetain( const QPainter* painter )
+{
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::Raster )
+        return false;
+
+    // the image can be composed pixel aligned only
+
+    const QTransform transform = painter->transform();
+    if ( transform.type() > QTransform::TxTranslate )
+        return false;
+
+    return transform.dx() == qRound( transform.dx() )
+        && transform.dy() == qRound( transform.dy() );
+}
 
 class QwtPlotItem::PrivateData
 {
@@ -28,6 +74,8 @@ class QwtPlotItem::PrivateData
         , yAxisId( QwtAxis::YLeft )
         , legendIconSize( 8, 8 )
     {
+        cache.isDirty = true;
+        cache.antialiased = false;
     }
 
     mutable QwtPlot* plot;
@@ -47,6 +95,20 @@ class QwtPlotItem::PrivateData
 
     QwtText title;
     QSize legendIconSize;
+
+    struct RetainedCache
+    {
+        bool isDirty;
+        bool antialiased;
+
+        QRect rect;
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+
+        QImage image;
+    };
+
+    mutable RetainedCache cache;
 };
 
 /*!
@@ -100,13 +162,21 @@ void QwtPlotItem::attach( QwtPlot* plot )
     if ( plot == m_data->plot )
         return;
 
+    const bool isDynamic = m_data->attributes.testFlag( Dynamic );
+
     if ( m_data->plot )
+    {
         m_data->plot->attachItem( this, false );
+        qwtInvalidateBackingStore( m_data->plot, isDynamic );
+    }
 
     m_data->plot = plot;
 
     if ( m_data->plot )
+    {
         m_data->plot->attachItem( this, true );
+        qwtInvalidateBackingStore( m_data->plot, isDynamic );
+    }
 }
 
 /*!
@@ -252,6 +322,12 @@ void QwtPlotItem::setItemAttribute( ItemAttribute attribute, bool on )
             }
         }
 
+        if ( attribute == QwtPlotItem::Retained && !on )
+            m_data->cache.image = QImage();
+
+        if ( attribute == QwtPlotItem::Dynamic && m_data->plot )
+            qwtInvalidateBackingStore( m_data->plot, false );
+
         itemChanged();
     }
 }
@@ -337,7 +413,8 @@ bool QwtPlotItem::testRenderHint( RenderHint hint ) const
 /*!
    On multi core systems rendering of certain plot item
    ( f.e QwtPlotRasterItem ) can be done in parallel in
-   several threads.
+   several threads. QwtPlotCurve uses the threads for mapping
+   the points of large series with QwtPlotCurve::FilterPointsAggressive.
 
    The default setting is set to 1.
 
@@ -480,10 +557,86 @@ bool QwtPlotItem::isVisible() const
  */
 void QwtPlotItem::itemChanged()
 {
+    m_data->cache.isDirty = true;
+
+    if ( m_data->plot )
+    {
+        qwtInvalidateBackingStore( m_data->plot,
+            m_data->attributes.testFlag( Dynamic ) );
+    }
+
     if ( m_data->plot )
         m_data->plot->autoRefresh();
 }
 
+/*!
+   \brief Draw the item using a retained image
+
+   When the item has been changed since the last call or the maps, the canvas
+   rectangle or the antialiasing hint are different, the item is
+   rendered by draw() into an image first. Then the image is composed
+   on the painter.
+
+   For paint engines other than QPaintEngine::Raster and
+   transformations other than an integer translation the item is
+   painted by draw() directly.
+
+   \param painter Painter
+   \param xMap Maps x-values into pixel coordinates.
+   \param yMap Maps y-values into pixel coordinates.
+   \param canvasRect Contents rect of the canvas in painter coordinates
+
+   \sa Retained, QwtPlot::drawItems()
+ */
+void QwtPlotItem::drawRetained( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect ) const
+{
+    if ( !qwtCanRetain( painter ) )
+    {
+        draw( painter, xMap, yMap, canvasRect );
+        return;
+    }
+
+    PrivateData::RetainedCache& cache = m_data->cache;
+
+    const QRect rect = canvasRect.toAlignedRect();
+    const bool antialiased = painter->testRenderHint( QPainter::Antialiasing );
+
+    const qreal pixelRatio = QwtPainter::devicePixelRatio( painter->device() );
+    const QSize size = rect.size() * pixelRatio;
+
+    if ( cache.isDirty || cache.image.size() != size || cache.rect != rect
+        || cache.antialiased != antialiased
+        || !cache.xMap.isSameMapping( xMap ) || !cache.yMap.isSameMapping( yMap ) )
+    {
+        if ( cache.image.size() != size )
+            cache.image = QImage( size, QImage::Format_ARGB32_Premultiplied );
+
+#if QT_VERSION >= 0x050000
+        cache.image.setDevicePixelRatio( pixelRatio );
+#endif
+        cache.image.fill( Qt::transparent );
+
+        QPainter imagePainter( &cache.image );
+        imagePainter.translate( -rect.topLeft() );
+        imagePainter.setFont( painter->font() );
+        imagePainter.setRenderHint( QPainter::Antialiasing, antialiased );
+
+        draw( &imagePainter, xMap, yMap, canvasRect );
+
+        imagePainter.end();
+
+        cache.isDirty = false;
+        cache.antialiased = antialiased;
+        cache.rect = rect;
+        cache.xMap = xMap;
+        cache.yMap = yMap;
+    }
+
+    painter->drawImage( rect.topLeft(), cache.image );
+}
+
 /*!
    Update the legend of the parent plot.
    \sa QwtPlot::updateLegend(), itemChanged()
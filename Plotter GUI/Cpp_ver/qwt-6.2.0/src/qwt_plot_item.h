@@ -161,7 +161,36 @@ class QWT_EXPORT QwtPlotItem
            its bounding rectangle.
            \sa getCanvasMarginHint()
          */
-        Margins = 0x04
+        Margins = 0x04,
+
+        /*!
+           The item is rendered into an image, that is reused by
+           QwtPlot::drawItems() as long as the item has not been changed
+           ( itemChanged() ) and the canvas maps are the same.
+
+           This is useful for static items on plots, where only a couple of
+           items are changing, f.e. a live curve on top of a huge
+           background curve. The image needs memory of the size of the canvas.
+
+           \note When the data of a series is modified without
+                 setSamples() dataChanged() has to be called.
+           \sa drawRetained()
+         */
+        Retained = 0x08,
+
+        /*!
+           The item is changing frequently, f.e. a curve displaying live data.
+
+           When the canvas is a QwtPlotCanvas with the
+           QwtPlotCanvas::LayeredBackingStore attribute, dynamic items
+           are painted on top of a cached layer with the background and all
+           other items. So changing a dynamic item doesn't
+           invalidate the cached layer.
+
+           \note In layered mode dynamic items are always on top of
+                 all other items regardless of their z() value.
+         */
+        Dynamic = 0x10
     };
 
     Q_DECLARE_FLAGS( ItemAttributes, ItemAttribute )
@@ -271,6 +300,10 @@ class QWT_EXPORT QwtPlotItem
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QRectF& canvasRect ) const = 0;
 
+    void drawRetained( QPainter* painter,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect ) const;
+
     virtual QRectF boundingRect() const;
 
     virtual void getCanvasMarginHint(
@@ -0,0 +1,535 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#include "qwt_plot_opengl_curve.h"
+#include "qwt_scale_map.h"
+#include "qwt_series_data.h"
+#include "qwt_text.h"
+
+#include <qpainter.h>
+#include <qpaintengine.h>
+#include <qpointer.h>
+#include <qvector.h>
+#include <qvector4d.h>
+#include <qopenglcontext.h>
+#include <qopenglfunctions.h>
+#include <qopenglbuffer.h>
+#include <qopenglshaderprogram.h>
+
+/*
+   The samples are stored relative to an origin, so that the
+   float precision of the buffer is sufficient. The vertex shader
+   maps them into normalized device coordinates.
+ */
+static const char qwtVertexShader[] =
+    "attribute highp vec2 vertex;\n"
+    "uniform highp vec4 transform;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    gl_Position = vec4( transform.x * vertex.x + transform.y,\n"
+    "        transform.z * vertex.y + transform.w, 0.0, 1.0 );\n"
+    "}\n";
+
+static const char qwtFragmentShader[] =
+    "uniform lowp vec4 color;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = color;\n"
+    "}\n";
+
+// the buffer is never smaller, when growing with the series
+static const int qwtMinRingSize = 1024;
+
+class QwtPlotOpenGLCurve::PrivateData
+{
+  public:
+    PrivateData()
+        : appendOnly( false )
+        , capacity( 0 )
+        , program( NULL )
+        , buffer( NULL )
+        , series( NULL )
+        , ringSize( 0 )
+        , numUploaded( 0 )
+        , isDirty( true )
+    {
+    }
+
+    ~PrivateData()
+    {
+        releaseResources();
+    }
+
+    void releaseResources()
+    {
+        delete program;
+        program = NULL;
+
+        delete buffer;
+        buffer = NULL;
+    }
+
+    void initResources( QOpenGLContext* );
+    void upload( const QwtSeriesData< QPointF >* );
+
+    bool appendOnly;
+    int capacity;
+
+    // OpenGL resources, that are valid for the context only
+    QPointer< QOpenGLContext > context;
+    QOpenGLShaderProgram* program;
+    QOpenGLBuffer* buffer;
+
+    // what has been uploaded to the buffer
+    const QwtSeriesData< QPointF >* series;
+    QPointF origin;
+    QPointF lastSample;
+
+    int ringSize;
+    int numUploaded;
+    bool isDirty;
+};
+
+void QwtPlotOpenGLCurve::PrivateData::initResources( QOpenGLContext* glContext )
+{
+    releaseResources();
+
+    context = glContext;
+    ringSize = 0;
+    isDirty = true;
+
+    QOpenGLShaderProgram* shaderProgram = new QOpenGLShaderProgram();
+
+    bool ok = shaderProgram->addShaderFromSourceCode(
+        QOpenGLShader::Vertex, qwtVertexShader );
+
+    if ( ok )
+    {
+        ok = shaderProgram->addShaderFromSourceCode(
+            QOpenGLShader::Fragment, qwtFragmentShader );
+    }
+
+    if ( ok )
+    {
+        shaderProgram->bindAttributeLocation( "vertex", 0 );
+        ok = shaderProgram->link();
+    }
+
+    if ( !ok )
+    {
+        // painting with QPainter for this context
+        delete shaderProgram;
+        return;
+    }
+
+    QOpenGLBuffer* vertexBuffer = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+    vertexBuffer->setUsagePattern( QOpenGLBuffer::DynamicDraw );
+
+    if ( !vertexBuffer->create() )
+    {
+        delete vertexBuffer;
+        delete shaderProgram;
+        return;
+    }
+
+    program = shaderProgram;
+    buffer = vertexBuffer;
+}
+
+/*
+   The buffer is a ring of ringSize vertices, where sample i is stored
+   at position i % ringSize. An additional vertex at the end mirrors the
+   first one, so that a line strip can be drawn across the wrap around.
+   The values are relative to origin, that is rebased on each upload of
+   all samples and whenever the ring wraps around.
+ */
+void QwtPlotOpenGLCurve::PrivateData::upload( const QwtSeriesData< QPointF >* data )
+{
+    const int numSamples = static_cast< int >( data->size() );
+
+    bool isValid = !isDirty && ( data == series ) && ( numSamples >= numUploaded );
+    if ( isValid && numUploaded > 0 )
+    {
+        // a series, that has been replaced by another one at the same address
+        isValid = data->sample( numUploaded - 1 ) == lastSample;
+    }
+
+    if ( !isValid )
+    {
+        series = data;
+        numUploaded = 0;
+        isDirty = false;
+    }
+
+    int size = capacity;
+    if ( size <= 0 )
+    {
+        size = qMax( ringSize, qwtMinRingSize );
+        while ( size < numSamples )
+            size *= 2;
+    }
+
+    buffer->bind();
+
+    if ( size != ringSize )
+    {
+        buffer->allocate( ( size + 1 ) * 2 * int( sizeof( GLfloat ) ) );
+
+        ringSize = size;
+        numUploaded = 0;
+    }
+
+    int from = qMax( numUploaded, numSamples - ringSize );
+
+    // does one of the new samples overwrite the beginning of the ring
+    const bool isWrapping = ( from < numSamples )
+        && ( ( numSamples - 1 ) / ringSize > qMax( from - 1, 0 ) / ringSize );
+
+    if ( numUploaded == 0 || isWrapping )
+    {
+        /*
+            The origin is rebased to the oldest sample in the ring, so that
+            the values stay small for long running series. Then all samples
+            in the ring have to be uploaded again - once for ringSize samples.
+         */
+        from = qMax( numSamples - ringSize, 0 );
+        origin = ( from < numSamples ) ? data->sample( from ) : QPointF();
+    }
+
+    QVector< GLfloat > values;
+
+    for ( int i = from; i < numSamples; )
+    {
+        const int pos = i % ringSize;
+        const int count = qMin( numSamples - i, ringSize - pos );
+
+        values.resize( 2 * count );
+
+        GLfloat* v = values.data();
+        for ( int j = 0; j < count; j++ )
+        {
+            const QPointF sample = data->sample( i + j );
+
+            *v++ = GLfloat( sample.x() - origin.x() );
+            *v++ = GLfloat( sample.y() - origin.y() );
+        }
+
+        const int vertexSize = 2 * int( sizeof( GLfloat ) );
+
+        buffer->write( pos * vertexSize, values.constData(), count * vertexSize );
+
+        if ( pos == 0 )
+            buffer->write( ringSize * vertexSize, values.constData(), vertexSize );
+
+        i += count;
+    }
+
+    buffer->release();
+
+    numUploaded = numSamples;
+    if ( numSamples > 0 )
+        lastSample = data->sample( numSamples - 1 );
+}
+
+/*!
+   Constructor
+   \param title Title of the curve
+ */
+QwtPlotOpenGLCurve::QwtPlotOpenGLCurve( const QString& title )
+    : QwtPlotCurve( title )
+{
+    m_data = new PrivateData;
+}
+
+/*!
+   Constructor
+   \param title Title of the curve
+ */
+QwtPlotOpenGLCurve::QwtPlotOpenGLCurve( const QwtText& title )
+    : QwtPlotCurve( title )
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtPlotOpenGLCurve::~QwtPlotOpenGLCurve()
+{
+    delete m_data;
+}
+
+/*!
+   \brief Upload new samples only
+
+   When appendOnly is enabled, the samples of the series are expected to
+   be unchanged, when the series is growing. Then only the appended
+   samples are uploaded to the vertex buffer - even if dataChanged()
+   has been called.
+
+   Replacing the series by setSamples() or setData() and shrinking
+   it is detected and results in uploading all samples. Modifications
+   in place need to be announced by invalidateBuffer().
+
+   The default setting is false.
+
+   \param on On/Off
+   \sa isAppendOnly(), setBufferCapacity(), invalidateBuffer()
+ */
+void QwtPlotOpenGLCurve::setAppendOnly( bool on )
+{
+    if ( on != m_data->appendOnly )
+    {
+        m_data->appendOnly = on;
+        m_data->isDirty = true;
+    }
+}
+
+/*!
+   \return True, when only appended samples are uploaded
+   \sa setAppendOnly()
+ */
+bool QwtPlotOpenGLCurve::isAppendOnly() const
+{
+    return m_data->appendOnly;
+}
+
+/*!
+   \brief Limit the size of the vertex buffer
+
+   With a capacity the vertex buffer is a ring, that holds
+   the latest numSamples samples. Older samples are not displayed.
+   This is intended for growing series, where only the latest
+   samples are of interest ( f.e. oscilloscopes ).
+
+   \param numSamples Capacity in samples. When numSamples is <= 0 the
+                     buffer grows with the series. The default setting is 0.
+
+   \sa bufferCapacity(), setAppendOnly()
+ */
+void QwtPlotOpenGLCurve::setBufferCapacity( int numSamples )
+{
+    numSamples = qMax( numSamples, 0 );
+
+    if ( numSamples != m_data->capacity )
+    {
+        m_data->capacity = numSamples;
+        m_data->isDirty = true;
+
+        itemChanged();
+    }
+}
+
+/*!
+   \return Capacity of the vertex buffer, 0 means unlimited
+   \sa setBufferCapacity()
+ */
+int QwtPlotOpenGLCurve::bufferCapacity() const
+{
+    return m_data->capacity;
+}
+
+/*!
+   \brief Upload all samples, when painting the next time
+
+   The vertex buffer is reused, as long as the series has not been
+   replaced by setSamples() or setData() and its size has not been
+   decreased. Samples, that have been modified in place, need
+   to be announced by invalidateBuffer() - even when isAppendOnly()
+   is disabled.
+
+   \sa setAppendOnly()
+ */
+void QwtPlotOpenGLCurve::invalidateBuffer()
+{
+    m_data->isDirty = true;
+    itemChanged();
+}
+
+/*!
+   \brief Notify a change of the series
+
+   Unless isAppendOnly() is enabled, all samples will be
+   uploaded to the vertex buffer, when painting the next time.
+ */
+void QwtPlotOpenGLCurve::dataChanged()
+{
+    if ( !m_data->appendOnly )
+        m_data->isDirty = true;
+
+    QwtPlotCurve::dataChanged();
+}
+
+/*!
+   \brief Draw lines
+
+   When possible the lines are drawn from the vertex buffer,
+   otherwise QwtPlotCurve::drawLines() is called.
+
+   \param painter Painter
+   \param xMap x map
+   \param yMap y map
+   \param canvasRect Contents rectangle of the canvas
+   \param from index of the first point to be painted
+   \param to index of the last point to be painted
+
+   \sa QwtPlotCurve::drawLines()
+ */
+void QwtPlotOpenGLCurve::drawLines( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    if ( !drawBuffer( painter, xMap, yMap, canvasRect, from, to ) )
+        QwtPlotCurve::drawLines( painter, xMap, yMap, canvasRect, from, to );
+}
+
+bool QwtPlotOpenGLCurve::drawBuffer( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& canvasRect, int from, int to ) const
+{
+    const QPaintEngine* engine = painter->paintEngine();
+    if ( engine == NULL || engine->type() != QPaintEngine::OpenGL2 )
+        return false;
+
+    if ( ( testCurveAttribute( Fitted ) && curveFitter() )
+        || brush().style() != Qt::NoBrush )
+    {
+        return false;
+    }
+
+    const QPen pen = painter->pen();
+    if ( pen.style() != Qt::SolidLine
+        || pen.brush().style() != Qt::SolidPattern || pen.widthF() > 1.0 )
+    {
+        return false;
+    }
+
+    // linear scales only
+    if ( xMap.transformation() || yMap.transformation() )
+        return false;
+
+    if ( xMap.s1() == xMap.s2() || yMap.s1() == yMap.s2() )
+        return false;
+
+    const QTransform transform = painter->deviceTransform();
+    if ( transform.type() > QTransform::TxScale )
+        return false;
+
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if ( context == NULL )
+        return false;
+
+    if ( context != m_data->context )
+        m_data->initResources( context );
+
+    if ( m_data->program == NULL )
+        return false;
+
+    QColor color = pen.color();
+    color.setAlphaF( color.alphaF() * painter->opacity() );
+
+    if ( from > to || color.alpha() == 0 )
+        return true;
+
+    painter->beginNativePainting();
+
+    QOpenGLFunctions* f = context->functions();
+
+    GLint viewport[4];
+    f->glGetIntegerv( GL_VIEWPORT, viewport );
+
+    m_data->upload( data() );
+
+    // samples, that are available in the ring
+
+    const int ringSize = m_data->ringSize;
+
+    from = qMax( from, m_data->numUploaded - ringSize );
+    to = qMin( to, m_data->numUploaded - 1 );
+
+    if ( from < to )
+    {
+        // scale maps, painter and viewport transformation in one step
+
+        const double ax = ( xMap.p2() - xMap.p1() ) / ( xMap.s2() - xMap.s1() );
+        const double bx = xMap.transform( m_data->origin.x() );
+
+        const double ay = ( yMap.p2() - yMap.p1() ) / ( yMap.s2() - yMap.s1() );
+        const double by = yMap.transform( m_data->origin.y() );
+
+        const double w = viewport[2];
+        const double h = viewport[3];
+
+        // aliased lines through the centers of the pixels like with QPainter
+        const double offset =
+            painter->testRenderHint( QPainter::Antialiasing ) ? 0.0 : 0.5;
+
+        const QVector4D vertexTransform(
+            2.0 * transform.m11() * ax / w,
+            2.0 * ( transform.m11() * bx + transform.dx() + offset ) / w - 1.0,
+            -2.0 * transform.m22() * ay / h,
+            1.0 - 2.0 * ( transform.m22() * by + transform.dy() + offset ) / h );
+
+        // premultiplied like the OpenGL paint engine
+
+        const qreal alpha = color.alphaF();
+        const QVector4D rgba( color.redF() * alpha,
+            color.greenF() * alpha, color.blueF() * alpha, alpha );
+
+        QRectF clipRect = canvasRect;
+        if ( painter->hasClipping() )
+            clipRect &= painter->clipBoundingRect();
+
+        const QRect scissorRect = transform.mapRect( clipRect ).toAlignedRect();
+
+        f->glEnable( GL_SCISSOR_TEST );
+        f->glScissor( viewport[0] + scissorRect.x(),
+            viewport[1] + viewport[3] - scissorRect.y() - scissorRect.height(),
+            scissorRect.width(), scissorRect.height() );
+
+        f->glEnable( GL_BLEND );
+        f->glBlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+        f->glLineWidth( 1.0f );
+
+        QOpenGLShaderProgram* program = m_data->program;
+
+        program->bind();
+        program->setUniformValue( "transform", vertexTransform );
+        program->setUniformValue( "color", rgba );
+
+        m_data->buffer->bind();
+
+        program->enableAttributeArray( 0 );
+        program->setAttributeBuffer( 0, GL_FLOAT, 0, 2 );
+
+        const int numPoints = to - from + 1;
+        const int pos = from % ringSize;
+
+        // up to the mirrored vertex at the end of the ring
+        const int numPoints1 = qMin( numPoints, ringSize + 1 - pos );
+        f->glDrawArrays( GL_LINE_STRIP, pos, numPoints1 );
+
+        if ( numPoints1 < numPoints )
+        {
+            // continuing at the beginning of the ring
+            f->glDrawArrays( GL_LINE_STRIP, 0, numPoints - numPoints1 + 1 );
+        }
+
+        program->disableAttributeArray( 0 );
+
+        m_data->buffer->release();
+        program->release();
+
+        f->glDisable( GL_SCISSOR_TEST );
+    }
+
+    painter->endNativePainting();
+
+    return true;
+}
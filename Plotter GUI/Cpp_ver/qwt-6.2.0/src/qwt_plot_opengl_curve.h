@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Qwt Widget Library
+ * Copyright (C) 1997   Josef Wilgen
+ * Copyright (C) 2002   Uwe Rathmann
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the Qwt License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QWT_PLOT_OPENGL_CURVE_H
+#define QWT_PLOT_OPENGL_CURVE_H
+
+#include "qwt_global.h"
+#include "qwt_plot_curve.h"
+
+/*!
+   \brief A curve, that renders its lines with OpenGL vertex buffers
+
+   When being painted by an OpenGL paint engine - f.e on a QwtPlotOpenGLCanvas -
+   QwtPlotOpenGLCurve uploads its samples into a vertex buffer object
+   and draws them as line strip, where the scale maps are applied
+   by a vertex shader. So the lines don't need to be tessellated by
+   QPainter for each replot.
+
+   For series, where samples are appended only ( isAppendOnly() ),
+   only the new samples are uploaded. With a bufferCapacity() the
+   buffer is a ring, that holds the latest samples only.
+
+   The series is not compared with the buffer for each replot. Only
+   setSamples(), setData() and appended samples are detected. Samples,
+   that have been modified in place ( f.e. by
+   QwtPointSeriesData::setSamples() with the same size ), are uploaded
+   after invalidateBuffer() only.
+
+   All situations, that can't be handled by the shaders, are painted
+   like by QwtPlotCurve:
+
+   - paint engines other than QPaintEngine::OpenGL2
+   - OpenGL contexts, where the shaders can't be built ( f.e core profiles )
+   - styles other than QwtPlotCurve::Lines, filled or fitted curves
+   - pens, that are not solid or wider than 1 pixel
+   - scales with a non linear transformation
+   - painter transformations beside scaling and translation
+
+   As the shaders only need OpenGL 2.0 or OpenGL ES 2.0 a software
+   implementation like the llvmpipe driver of Mesa can be used on systems
+   without a GPU.
+
+   \sa QwtPlotOpenGLCanvas, QwtPlotCurve
+ */
+class QWT_EXPORT QwtPlotOpenGLCurve : public QwtPlotCurve
+{
+  public:
+    explicit QwtPlotOpenGLCurve( const QString& title = QString() );
+    explicit QwtPlotOpenGLCurve( const QwtText& title );
+
+    virtual ~QwtPlotOpenGLCurve();
+
+    void setAppendOnly( bool );
+    bool isAppendOnly() const;
+
+    void setBufferCapacity( int numSamples );
+    int bufferCapacity() const;
+
+    void invalidateBuffer();
+
+  protected:
+    virtual void dataChanged() QWT_OVERRIDE;
+
+    virtual void drawLines( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const QWT_OVERRIDE;
+
+  private:
+    bool drawBuffer( QPainter*,
+        const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QRectF& canvasRect, int from, int to ) const;
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
+#endif
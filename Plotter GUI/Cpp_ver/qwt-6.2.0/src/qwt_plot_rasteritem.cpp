@@ -13,14 +13,133 @@
 #include "qwt_text.h"
 #include "qwt_interval.h"
 #include "qwt_math.h"
+#include "qwt_plot.h"
 
 #include <qpainter.h>
 #include <qpaintengine.h>
 #include <qthread.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
+#include <qmutex.h>
+#include <qmap.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qevent.h>
+#include <qcoreapplication.h>
+#include <qatomic.h>
 
 #include <limits>
+#include <algorithm>
+#include <cmath>
+
+// width and height of a tile of the TileCache in device pixels
+static const int qwtTileSize = 256;
+
+// a preview of a missing tile has a lower resolution by this factor
+static const int qwtPreviewFactor = 8;
+
+// least recently used tiles are dropped beyond this limit
+static const int qwtMaxTiles = 128;
+
+// tiles of other resolutions are dropped beyond this limit
+static const int qwtMaxZoomLevels = 8;
+
+namespace
+{
+    class QwtRasterTileKey
+    {
+      public:
+        inline bool operator<( const QwtRasterTileKey& other ) const
+        {
+            if ( zoomLevel != other.zoomLevel )
+                return zoomLevel < other.zoomLevel;
+
+            if ( row != other.row )
+                return row < other.row;
+
+            return column < other.column;
+        }
+
+        qint64 column;
+        qint64 row;
+        int zoomLevel;
+    };
+
+    class QwtRasterTile
+    {
+      public:
+        QwtRasterTile()
+            : isPreview( true )
+            , isPending( false )
+            , lastUsed( 0 )
+        {
+        }
+
+        QImage image;
+        bool isPreview;
+        bool isPending;
+        qint64 lastUsed;
+
+        // scale coordinates of the first and the last pixel corner, not normalized
+        QRectF corners;
+    };
+
+    class QwtRasterZoomLevel
+    {
+      public:
+        int id;
+
+        // size of a device pixel in scale coordinates
+        double dx;
+        double dy;
+    };
+
+    /*
+        Posting an event from a worker thread is the only way
+        to get back to the GUI thread without an additional
+        moc-ed class. Pending events are discarded, when the
+        notifier is deleted.
+     */
+    class QwtRasterTileNotifier : public QObject
+    {
+      public:
+        explicit QwtRasterTileNotifier( QwtPlotItem* item )
+            : m_item( item )
+        {
+        }
+
+        void notify()
+        {
+            // many tiles might be finished before the next replot
+
+            if ( m_pending.testAndSetOrdered( 0, 1 ) )
+                QCoreApplication::postEvent( this, new QEvent( QEvent::User ) );
+        }
+
+        virtual bool event( QEvent* event ) QWT_OVERRIDE
+        {
+            if ( event->type() == QEvent::User )
+            {
+                m_pending.storeRelease( 0 );
+
+                // invalidating retained images and backing stores
+                m_item->itemChanged();
+
+                QwtPlot* plot = m_item->plot();
+                if ( plot && !plot->autoReplot() )
+                    plot->replot();
+
+                return true;
+            }
+
+            return QObject::event( event );
+        }
+
+      private:
+        QwtPlotItem* m_item;
+        QAtomicInt m_pending;
+    };
+}
 
 class QwtPlotRasterItem::PrivateData
 {
@@ -30,12 +149,55 @@ class QwtPlotRasterItem::PrivateData
         , paintAttributes( QwtPlotRasterItem::PaintInDeviceResolution )
     {
         cache.policy = QwtPlotRasterItem::NoCache;
+
+        tileCache.generation = 0;
+        tileCache.nextZoomLevel = 0;
+        tileCache.usage = 0;
+        tileCache.isRendering = false;
+        tileCache.notifier = NULL;
     }
 
+    ~PrivateData()
+    {
+        delete tileCache.notifier;
+    }
+
+    /*
+        Tiles, that are rendered in a worker thread, are not
+        inserted, when the cache has been discarded in between.
+     */
+    class TileJob
+    {
+      public:
+        QwtRasterTileKey key;
+        int generation;
+
+        QwtScaleMap xMap;
+        QwtScaleMap yMap;
+        QRectF area;
+    };
+
+    static void renderTiles( const QwtPlotRasterItem* );
+
+    void discardTiles();
+    void dropTiles( qint64 usage );
+    int zoomLevel( double dx, double dy );
+
+    void drawOtherZoomLevels( QPainter*, int zoomLevelId,
+        double x0, double y0, double dx, double dy,
+        const QRectF& tileArea, const QRectF& targetRect ) const;
+
     int alpha;
 
     QwtPlotRasterItem::PaintAttributes paintAttributes;
 
+    /*
+        renderImage() is never called concurrently, so that
+        implementations can rely on calling initRaster()/discardRaster()
+        of their data in pairs.
+     */
+    QMutex renderMutex;
+
     struct ImageCache
     {
         QwtPlotRasterItem::CachePolicy policy;
@@ -43,8 +205,165 @@ class QwtPlotRasterItem::PrivateData
         QSizeF size;
         QImage image;
     } cache;
+
+    struct TileCache
+    {
+        QMutex mutex;
+
+        QMap< QwtRasterTileKey, QwtRasterTile > tiles;
+        QVector< QwtRasterZoomLevel > zoomLevels;
+
+        int generation;
+        int nextZoomLevel;
+        qint64 usage;
+
+        // the jobs are processed by one worker in the order of their request
+        QList< TileJob > jobs;
+        bool isRendering;
+        QFuture< void > worker;
+
+        QwtRasterTileNotifier* notifier;
+    } tileCache;
 };
 
+void QwtPlotRasterItem::PrivateData::renderTiles( const QwtPlotRasterItem* item )
+{
+    QwtPlotRasterItem::PrivateData* d = item->m_data;
+    TileCache& cache = d->tileCache;
+
+    while ( true )
+    {
+        TileJob job;
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( cache.jobs.isEmpty() )
+            {
+                cache.isRendering = false;
+                return;
+            }
+
+            job = cache.jobs.takeFirst();
+        }
+
+        QImage image;
+
+        {
+            QMutexLocker locker( &d->renderMutex );
+
+            image = item->renderImage( job.xMap, job.yMap,
+                job.area, QSize( qwtTileSize, qwtTileSize ) );
+        }
+
+        {
+            QMutexLocker locker( &cache.mutex );
+
+            if ( job.generation != cache.generation )
+                continue;
+
+            QMap< QwtRasterTileKey, QwtRasterTile >::iterator it =
+                cache.tiles.find( job.key );
+
+            if ( it == cache.tiles.end() )
+                continue; // dropped in between
+
+            it->image = image;
+            it->isPreview = false;
+            it->isPending = false;
+        }
+
+        cache.notifier->notify();
+    }
+}
+
+void QwtPlotRasterItem::PrivateData::discardTiles()
+{
+    {
+        QMutexLocker locker( &tileCache.mutex );
+
+        tileCache.generation++;
+        tileCache.tiles.clear();
+        tileCache.zoomLevels.clear();
+        tileCache.jobs.clear();
+    }
+
+    // waiting for the tile, that is in progress
+    tileCache.worker.waitForFinished();
+}
+
+void QwtPlotRasterItem::PrivateData::dropTiles( qint64 usage )
+{
+    // the mutex is locked by the caller
+
+    QMap< QwtRasterTileKey, QwtRasterTile >& tiles = tileCache.tiles;
+    if ( tiles.size() <= qwtMaxTiles )
+        return;
+
+    QVector< qint64 > usages;
+    usages.reserve( tiles.size() );
+
+    for ( QMap< QwtRasterTileKey, QwtRasterTile >::const_iterator
+        it = tiles.constBegin(); it != tiles.constEnd(); ++it )
+    {
+        usages += it->lastUsed;
+    }
+
+    std::sort( usages.begin(), usages.end() );
+
+    // tiles of the current draw operation are never dropped
+    const qint64 limit = qMin( usages[ tiles.size() - qwtMaxTiles - 1 ], usage - 1 );
+
+    QMap< QwtRasterTileKey, QwtRasterTile >::iterator it = tiles.begin();
+    while ( it != tiles.end() )
+    {
+        if ( it->lastUsed <= limit )
+            it = tiles.erase( it );
+        else
+            ++it;
+    }
+}
+
+int QwtPlotRasterItem::PrivateData::zoomLevel( double dx, double dy )
+{
+    // the mutex is locked by the caller
+
+    QVector< QwtRasterZoomLevel >& zoomLevels = tileCache.zoomLevels;
+
+    for ( int i = 0; i < zoomLevels.size(); i++ )
+    {
+        // panning changes the resolution by rounding errors only
+
+        const QwtRasterZoomLevel& zoomLevel = zoomLevels[i];
+        if ( qFuzzyCompare( zoomLevel.dx, dx ) && qFuzzyCompare( zoomLevel.dy, dy ) )
+            return i;
+    }
+
+    if ( zoomLevels.size() >= qwtMaxZoomLevels )
+    {
+        const int id = zoomLevels.first().id;
+        zoomLevels.remove( 0 );
+
+        QMap< QwtRasterTileKey, QwtRasterTile >::iterator it = tileCache.tiles.begin();
+        while ( it != tileCache.tiles.end() )
+        {
+            if ( it.key().zoomLevel == id )
+                it = tileCache.tiles.erase( it );
+            else
+                ++it;
+        }
+    }
+
+    QwtRasterZoomLevel zoomLevel;
+    zoomLevel.id = tileCache.nextZoomLevel++;
+    zoomLevel.dx = dx;
+    zoomLevel.dy = dy;
+
+    zoomLevels += zoomLevel;
+
+    return zoomLevels.size() - 1;
+}
+
 
 static QRectF qwtAlignRect(const QRectF& rect)
 {
@@ -365,7 +684,7 @@ static bool qwtUseCache( QwtPlotRasterItem::CachePolicy policy,
 {
     bool doCache = false;
 
-    if ( policy == QwtPlotRasterItem::PaintCache )
+    if ( policy != QwtPlotRasterItem::NoCache )
     {
         // Caching doesn't make sense, when the item is
         // not painted to screen
@@ -430,6 +749,63 @@ static void qwtToRgba( const QImage* from, QImage* to,
     }
 }
 
+static QImage qwtAlphaImage( const QImage& image, int alpha )
+{
+    if ( alpha < 0 || alpha >= 255 || image.isNull() )
+        return image;
+
+    QImage alphaImage( image.size(), QImage::Format_ARGB32 );
+    qwtToRgba( &image, &alphaImage, alphaImage.rect(), alpha );
+
+    return alphaImage;
+}
+
+/*
+   Paint the tiles of other zoom levels, that intersect with a missing
+   tile, while the worker thread is rendering. The mutex of the tile
+   cache is locked by the caller.
+ */
+void QwtPlotRasterItem::PrivateData::drawOtherZoomLevels( QPainter* painter,
+    int zoomLevelId, double x0, double y0, double dx, double dy,
+    const QRectF& tileArea, const QRectF& targetRect ) const
+{
+    bool isClipped = false;
+
+    for ( QMap< QwtRasterTileKey, QwtRasterTile >::const_iterator
+        it = tileCache.tiles.constBegin(); it != tileCache.tiles.constEnd(); ++it )
+    {
+        const QwtRasterTile& tile = it.value();
+
+        if ( it.key().zoomLevel == zoomLevelId || tile.image.isNull() )
+            continue;
+
+        if ( !tile.corners.normalized().intersects( tileArea ) )
+            continue;
+
+        const QRectF& c = tile.corners;
+
+        const QRectF rect( QPointF( x0 + c.left() / dx, y0 + c.top() / dy ),
+            QPointF( x0 + c.right() / dx, y0 + c.bottom() / dy ) );
+
+        // zoom levels of inverted scales are not mirrored
+        if ( rect.width() <= 0.0 || rect.height() <= 0.0 )
+            continue;
+
+        if ( !isClipped )
+        {
+            painter->save();
+            painter->setClipRect( targetRect, Qt::IntersectClip );
+
+            isClipped = true;
+        }
+
+        painter->drawImage( rect, qwtAlphaImage( tile.image, alpha ) );
+    }
+
+    if ( isClipped )
+        painter->restore();
+}
+
 //! Constructor
 QwtPlotRasterItem::QwtPlotRasterItem( const QString& title )
     : QwtPlotItem( QwtText( title ) )
@@ -447,6 +823,13 @@ QwtPlotRasterItem::QwtPlotRasterItem( const QwtText& title )
 //! Destructor
 QwtPlotRasterItem::~QwtPlotRasterItem()
 {
+    {
+        // derived classes have to stop the worker in their destructor
+        QMutexLocker locker( &m_data->tileCache.mutex );
+        Q_ASSERT( !m_data->tileCache.isRendering );
+    }
+
+    m_data->discardTiles();
     delete m_data;
 }
 
@@ -563,6 +946,11 @@ QwtPlotRasterItem::CachePolicy QwtPlotRasterItem::cachePolicy() const
 
 /*!
    Invalidate the paint cache
+
+   Tiles of the TileCache, that are rendered in worker threads,
+   are discarded. invalidateCache() waits until running jobs are finished,
+   so that the data can be modified safely afterwards.
+
    \sa setCachePolicy()
  */
 void QwtPlotRasterItem::invalidateCache()
@@ -570,6 +958,28 @@ void QwtPlotRasterItem::invalidateCache()
     m_data->cache.image = QImage();
     m_data->cache.area = QRect();
     m_data->cache.size = QSize();
+
+    m_data->discardTiles();
+}
+
+/*!
+   \brief Mutex, that serializes the calls of renderImage()
+
+   With the TileCache policy renderImage() is called from a worker
+   thread, while the item is drawn in the GUI thread. As all calls
+   of renderImage() are done with renderMutex() being locked,
+   implementations can rely on initializing and discarding
+   the state of their data in pairs.
+
+   Derived classes have to lock it, when they access the same
+   state from draw() outside of renderImage().
+
+   \return Mutex, that is locked around renderImage()
+   \sa TileCache
+ */
+QMutex* QwtPlotRasterItem::renderMutex() const
+{
+    return &m_data->renderMutex;
 }
 
 /*!
@@ -681,6 +1091,12 @@ void QwtPlotRasterItem::draw( QPainter* painter,
 
     if ( pixelRect.isEmpty() )
     {
+        if ( doCache && m_data->cache.policy == TileCache )
+        {
+            if ( drawTiles( painter, xxMap, yyMap, paintRect ) )
+                return;
+        }
+
         if ( QwtPainter::roundingAlignment( painter ) )
         {
             // we want to have maps, where the boundaries of
@@ -767,6 +1183,200 @@ void QwtPlotRasterItem::draw( QPainter* painter,
     painter->restore();
 }
 
+/*!
+   \brief Draw the raster data from the tile cache
+
+   The tiles are anchored at the origin of the scale coordinates,
+   so that they can be reused for all positions of the same zoom level.
+   Missing tiles are painted from a preview of lower resolution, while
+   the tiles are rendered in worker threads. The plot is replotted,
+   when they are available.
+
+   \param painter Painter
+   \param xMap X-Scale Map in paint device coordinates
+   \param yMap Y-Scale Map in paint device coordinates
+   \param paintRect Bounding rectangle of the data in paint device coordinates
+
+   \return false, when the tiles can't be used for the maps
+   \sa TileCache, invalidateCache()
+ */
+bool QwtPlotRasterItem::drawTiles( QPainter* painter,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QRectF& paintRect ) const
+{
+    // tiles can be reused for linear scales only
+    if ( xMap.transformation() || yMap.transformation() )
+        return false;
+
+    if ( xMap.p1() == xMap.p2() || yMap.p1() == yMap.p2() )
+        return false;
+
+    double dx = ( xMap.s2() - xMap.s1() ) / ( xMap.p2() - xMap.p1() );
+    double dy = ( yMap.s2() - yMap.s1() ) / ( yMap.p2() - yMap.p1() );
+
+    if ( dx == 0.0 || dy == 0.0 )
+        return false;
+
+    const QRectF rect = paintRect.normalized();
+
+    PrivateData::TileCache& cache = m_data->tileCache;
+
+    if ( cache.notifier == NULL )
+    {
+        cache.notifier = new QwtRasterTileNotifier(
+            const_cast< QwtPlotRasterItem* >( this ) );
+    }
+
+    QMutexLocker locker( &cache.mutex );
+
+    const QwtRasterZoomLevel zoomLevel =
+        cache.zoomLevels[ m_data->zoomLevel( dx, dy ) ];
+
+    dx = zoomLevel.dx;
+    dy = zoomLevel.dy;
+
+    // paint position of the origin, where the tiles are anchored
+    const double x0 = qRound( xMap.p1() - xMap.s1() / dx );
+    const double y0 = qRound( yMap.p1() - yMap.s1() / dy );
+
+    const double col1 = std::floor( ( rect.left() - x0 ) / qwtTileSize );
+    const double col2 = std::floor( ( rect.right() - x0 ) / qwtTileSize );
+    const double row1 = std::floor( ( rect.top() - y0 ) / qwtTileSize );
+    const double row2 = std::floor( ( rect.bottom() - y0 ) / qwtTileSize );
+
+    const double limit = 1.0e15;
+    if ( qAbs( col1 ) > limit || qAbs( col2 ) > limit
+        || qAbs( row1 ) > limit || qAbs( row2 ) > limit
+        || ( col2 - col1 + 1 ) * ( row2 - row1 + 1 ) > qwtMaxTiles )
+    {
+        return false;
+    }
+
+    const qint64 usage = ++cache.usage;
+
+    painter->save();
+    painter->setWorldTransform( QTransform() );
+    painter->setClipRect( rect, Qt::IntersectClip );
+
+    for ( qint64 row = qint64( row1 ); row <= qint64( row2 ); row++ )
+    {
+        for ( qint64 col = qint64( col1 ); col <= qint64( col2 ); col++ )
+        {
+            QwtRasterTileKey key;
+            key.column = col;
+            key.row = row;
+            key.zoomLevel = zoomLevel.id;
+
+            // pixel i of the tile is at the paint position x0 + col * size + i
+
+            const double u1 = double( col ) * qwtTileSize;
+            const double u2 = u1 + qwtTileSize;
+            const double v1 = double( row ) * qwtTileSize;
+            const double v2 = v1 + qwtTileSize;
+
+            const QRectF corners( QPointF( u1 * dx, v1 * dy ),
+                QPointF( u2 * dx, v2 * dy ) );
+
+            const QRectF tileArea = corners.normalized();
+
+            QwtRasterTile& tile = cache.tiles[key];
+            tile.lastUsed = usage;
+            tile.corners = corners;
+
+            if ( tile.image.isNull() )
+            {
+                // a preview with a lower resolution, painted immediately
+
+                const int previewSize = qwtTileSize / qwtPreviewFactor;
+
+                QwtScaleMap xxMap = xMap;
+                xxMap.setPaintInterval( 0.0, previewSize );
+                xxMap.setScaleInterval( u1 * dx, u2 * dx );
+
+                QwtScaleMap yyMap = yMap;
+                yyMap.setPaintInterval( 0.0, previewSize );
+                yyMap.setScaleInterval( v1 * dy, v2 * dy );
+
+                /*
+                    Only the GUI thread inserts or removes tiles, so
+                    the tile stays valid, while the workers can
+                    store their results in between.
+
+                    The GUI thread never waits for the worker: while a tile
+                    is rendered, the tiles of other zoom levels are painted
+                    instead of the preview.
+                 */
+                locker.unlock();
+
+                QImage preview;
+
+                if ( m_data->renderMutex.tryLock() )
+                {
+                    preview = renderImage( xxMap, yyMap,
+                        tileArea, QSize( previewSize, previewSize ) );
+
+                    m_data->renderMutex.unlock();
+                }
+
+                locker.relock();
+
+                if ( tile.image.isNull() && !preview.isNull() )
+                {
+                    tile.image = preview;
+                    tile.isPreview = true;
+                }
+            }
+
+            if ( tile.isPreview && !tile.isPending )
+            {
+                PrivateData::TileJob job;
+                job.key = key;
+                job.generation = cache.generation;
+                job.area = tileArea;
+
+                job.xMap = xMap;
+                job.xMap.setPaintInterval( 0.0, qwtTileSize );
+                job.xMap.setScaleInterval( u1 * dx, u2 * dx );
+
+                job.yMap = yMap;
+                job.yMap.setPaintInterval( 0.0, qwtTileSize );
+                job.yMap.setScaleInterval( v1 * dy, v2 * dy );
+
+                tile.isPending = true;
+                cache.jobs += job;
+
+                if ( !cache.isRendering )
+                {
+                    // a previous worker has nothing to do beside returning
+                    cache.worker.waitForFinished();
+
+                    cache.isRendering = true;
+                    cache.worker = QtConcurrent::run( &PrivateData::renderTiles, this );
+                }
+            }
+
+            const QRectF targetRect( x0 + u1, y0 + v1, qwtTileSize, qwtTileSize );
+
+            if ( tile.image.isNull() )
+            {
+                m_data->drawOtherZoomLevels( painter, zoomLevel.id,
+                    x0, y0, dx, dy, tileArea, targetRect );
+            }
+            else
+            {
+                painter->drawImage( targetRect,
+                    qwtAlphaImage( tile.image, m_data->alpha ) );
+            }
+        }
+    }
+
+    painter->restore();
+
+    m_data->dropTiles( usage );
+
+    return true;
+}
+
 /*!
    \return Bounding interval for an axis
 
@@ -859,7 +1469,10 @@ QImage QwtPlotRasterItem::compose(
         const QwtScaleMap yyMap =
             imageMap(Qt::Vertical, yMap, imageArea, imageSize, dy);
 
-        image = renderImage( xxMap, yyMap, imageArea, imageSize );
+        {
+            QMutexLocker locker( &m_data->renderMutex );
+            image = renderImage( xxMap, yyMap, imageArea, imageSize );
+        }
 
         if ( doCache )
         {
@@ -16,6 +16,7 @@
 #include <qstring.h>
 
 class QwtInterval;
+class QMutex;
 
 /*!
    \brief A class, which displays raster data
@@ -56,7 +57,39 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
            of hide/show operations or manipulations of the alpha value.
            All other situations are handled by the canvas backing store.
          */
-        PaintCache
+        PaintCache,
+
+        /*!
+           The image is composed from tiles of 256x256 device pixels,
+           that are anchored at the origin of the scale coordinates.
+           The tiles are cached for a couple of zoom levels, the least
+           recently used tiles are dropped.
+
+           Missing tiles are painted from a preview of a lower resolution
+           first, while renderImage() is called for the tiles in a worker thread.
+           When the worker is busy, the cached tiles of other zoom levels
+           are painted instead of the preview. The item is changed
+           ( itemChanged() ), when the tiles are available.
+           So panning only needs to render the tiles, that have become
+           visible, without blocking the GUI thread.
+
+           As renderImage() is called from a worker thread, the data
+           must not be modified without calling invalidateCache() before.
+           Calls of renderImage() are serialized by renderMutex(), so
+           that it is never called concurrently. Derived classes have to
+           lock renderMutex(), when accessing the data from draw()
+           outside of renderImage().
+
+           The destructor of QwtPlotRasterItem is too late for stopping
+           the worker, as renderImage() can't be called anymore. So derived
+           classes have to call invalidateCache() in their destructor,
+           what is asserted in debug builds.
+
+           Tiles can be used for linear scales, when the image is rendered
+           in paint device resolution only. All other situations are
+           handled like PaintCache.
+         */
+        TileCache
     };
 
     /*!
@@ -95,7 +128,7 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
     void setCachePolicy( CachePolicy );
     CachePolicy cachePolicy() const;
 
-    void invalidateCache();
+    virtual void invalidateCache();
 
     virtual void draw( QPainter*,
         const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -131,12 +164,17 @@ class QWT_EXPORT QwtPlotRasterItem : public QwtPlotItem
         const QwtScaleMap& map, const QRectF& area,
         const QSize& imageSize, double pixelSize) const;
 
+    QMutex* renderMutex() const;
+
   private:
     explicit QwtPlotRasterItem( const QwtPlotRasterItem& );
     QwtPlotRasterItem& operator=( const QwtPlotRasterItem& );
 
     void init();
 
+    bool drawTiles( QPainter*, const QwtScaleMap&, const QwtScaleMap&,
+        const QRectF& paintRect ) const;
+
     QImage compose( const QwtScaleMap&, const QwtScaleMap&,
         const QRectF& imageArea, const QRectF& paintRect,
         const QSize& imageSize, bool doCache) const;
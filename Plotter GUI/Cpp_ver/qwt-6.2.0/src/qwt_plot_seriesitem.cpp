@@ -94,6 +94,15 @@ void QwtPlotSeriesItem::draw( QPainter* painter,
     drawSeries( painter, xMap, yMap, canvasRect, 0, -1 );
 }
 
+/*!
+   \return Bounding rectangle of the series data
+
+   For a growing series the rectangle should be maintained by the
+   data object itself - like QwtAppendablePointData does - as
+   it is requested by autoscaling for each replot.
+
+   \sa QwtSeriesStore::dataRect()
+ */
 QRectF QwtPlotSeriesItem::boundingRect() const
 {
     return dataRect();
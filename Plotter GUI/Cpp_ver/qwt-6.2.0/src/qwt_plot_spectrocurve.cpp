@@ -276,47 +276,81 @@ void QwtPlotSpectroCurve::drawDots( QPainter* painter,
 
     const bool doAlign = QwtPainter::roundingAlignment( painter );
 
-    const QwtColorMap::Format format = m_data->colorMap->format();
+    const QwtColorMap* colorMap = m_data->colorMap;
+
+    const QwtColorMap::Format format = colorMap->format();
     if ( format == QwtColorMap::Indexed )
-        m_data->colorTable = m_data->colorMap->colorTable256();
+        m_data->colorTable = colorMap->colorTable256();
+
+    /*
+        The colors are mapped for blocks of samples, what is
+        a single table lookup per sample for color maps with
+        a lookup table ( QwtColorMap::setLookupTableSize() ).
+     */
 
-    const QwtSeriesData< QwtPoint3D >* series = data();
+    QVector< double > zValues;
+    QVector< QRgb > rgbs;
+    QVector< uint > indexes;
 
-    for ( int i = from; i <= to; i++ )
+    bool hasPen = false;
+    QRgb penRgb = 0u;
+
+    QwtSeriesBlockReader< QwtPoint3D > reader( data(), from, to );
+    while ( reader.next() )
     {
-        const QwtPoint3D sample = series->sample( i );
+        const QwtPoint3D* samples = reader.samples();
+        const int count = reader.count();
 
-        double xi = xMap.transform( sample.x() );
-        double yi = yMap.transform( sample.y() );
-        if ( doAlign )
+        if ( zValues.size() < count )
         {
-            xi = qRound( xi );
-            yi = qRound( yi );
+            zValues.resize( count );
+            rgbs.resize( count );
+            indexes.resize( count );
         }
 
-        if ( m_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints )
-        {
-            if ( !canvasRect.contains( xi, yi ) )
-                continue;
-        }
+        for ( int i = 0; i < count; i++ )
+            zValues[i] = samples[i].z();
 
         if ( format == QwtColorMap::RGB )
         {
-            const QRgb rgb = m_data->colorMap->rgb(
-                m_data->colorRange, sample.z() );
-
-            painter->setPen( QPen( QColor::fromRgba( rgb ), m_data->penWidth ) );
+            colorMap->rgbRow( m_data->colorRange,
+                zValues.constData(), rgbs.data(), count );
         }
         else
         {
-            const unsigned char index = m_data->colorMap->colorIndex(
-                256, m_data->colorRange, sample.z() );
+            colorMap->colorIndexRow( 256, m_data->colorRange,
+                zValues.constData(), indexes.data(), count );
 
-            painter->setPen( QPen( QColor::fromRgba( m_data->colorTable[index] ),
-                m_data->penWidth ) );
+            for ( int i = 0; i < count; i++ )
+                rgbs[i] = m_data->colorTable[ indexes[i] & 0xff ];
         }
 
-        QwtPainter::drawPoint( painter, QPointF( xi, yi ) );
+        for ( int i = 0; i < count; i++ )
+        {
+            double xi = xMap.transform( samples[i].x() );
+            double yi = yMap.transform( samples[i].y() );
+            if ( doAlign )
+            {
+                xi = qRound( xi );
+                yi = qRound( yi );
+            }
+
+            if ( m_data->paintAttributes & QwtPlotSpectroCurve::ClipPoints )
+            {
+                if ( !canvasRect.contains( xi, yi ) )
+                    continue;
+            }
+
+            if ( !hasPen || rgbs[i] != penRgb )
+            {
+                penRgb = rgbs[i];
+                hasPen = true;
+
+                painter->setPen( QPen( QColor::fromRgba( penRgb ), m_data->penWidth ) );
+            }
+
+            QwtPainter::drawPoint( painter, QPointF( xi, yi ) );
+        }
     }
 
     m_data->colorTable.clear();
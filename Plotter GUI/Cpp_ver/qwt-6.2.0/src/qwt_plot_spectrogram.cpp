@@ -15,9 +15,12 @@
 #include "qwt_math.h"
 
 #include <qimage.h>
+#include <qmap.h>
+#include <qpair.h>
 #include <qpen.h>
 #include <qpainter.h>
 #include <qthread.h>
+#include <qmutex.h>
 #include <qfuture.h>
 #include <qtconcurrentrun.h>
 
@@ -28,6 +31,16 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+
+// number of image rows, that are resampled in one go
+static const int qwtBandHeight = 32;
+
+// number of raster cells in each direction of a cached contour tile
+static const int qwtContourTileSize = 64;
+
+// tiles, that are not visible, are dropped beyond this limit
+static const int qwtMaxContourTiles = 1024;
 
 static inline bool qwtIsNaN( double d )
 {
@@ -92,6 +105,32 @@ class QwtPlotSpectrogram::PrivateData
 
     int colorTableSize;
     QVector< QRgb > colorTable;
+
+    /*
+        Contour lines for tiles of raster cells. The raster is
+        anchored at the origin, so that the tiles can be reused,
+        as long as the resolution does not change.
+     */
+    class ContourCache
+    {
+      public:
+        ContourCache()
+            : dx( 0.0 )
+            , dy( 0.0 )
+        {
+        }
+
+        void clear()
+        {
+            dx = dy = 0.0;
+            tiles.clear();
+        }
+
+        double dx;
+        double dy;
+
+        QMap< QPair< qint64, qint64 >, QwtRasterData::ContourLines > tiles;
+    } contourCache;
 };
 
 /*!
@@ -119,6 +158,9 @@ QwtPlotSpectrogram::QwtPlotSpectrogram( const QString& title )
 //! Destructor
 QwtPlotSpectrogram::~QwtPlotSpectrogram()
 {
+    // waiting for tiles, that are rendered in worker threads
+    invalidateCache();
+
     delete m_data;
 }
 
@@ -179,6 +221,9 @@ void QwtPlotSpectrogram::setColorMap( QwtColorMap* colorMap )
     if ( colorMap == NULL )
         return;
 
+    // tiles might be rendered with the previous color map
+    invalidateCache();
+
     if ( colorMap != m_data->colorMap )
     {
         delete m_data->colorMap;
@@ -187,8 +232,6 @@ void QwtPlotSpectrogram::setColorMap( QwtColorMap* colorMap )
 
     m_data->updateColorTable();
 
-    invalidateCache();
-
     legendChanged();
     itemChanged();
 }
@@ -226,9 +269,10 @@ void QwtPlotSpectrogram::setColorTableSize( int numColors )
     numColors = qMax( numColors, 0 );
     if ( numColors != m_data->colorTableSize )
     {
+        invalidateCache();
+
         m_data->colorTableSize = numColors;
         m_data->updateColorTable();
-        invalidateCache();
     }
 }
 /*!
@@ -332,6 +376,7 @@ void QwtPlotSpectrogram::setConrecFlag(
     else
         m_data->conrecFlags &= ~flag;
 
+    m_data->contourCache.clear();
     itemChanged();
 }
 
@@ -367,6 +412,8 @@ void QwtPlotSpectrogram::setContourLevels( const QList< double >& levels )
     m_data->contourLevels = levels;
     std::sort( m_data->contourLevels.begin(), m_data->contourLevels.end() );
 
+    m_data->contourCache.clear();
+
     legendChanged();
     itemChanged();
 }
@@ -394,14 +441,30 @@ void QwtPlotSpectrogram::setData( QwtRasterData* data )
 {
     if ( data != m_data->data )
     {
+        invalidateCache();
+
         delete m_data->data;
         m_data->data = data;
 
-        invalidateCache();
         itemChanged();
     }
 }
 
+/*!
+   Invalidate the paint cache and the cached contour lines
+
+   When the values of the raster data have been modified without
+   calling setData(), the caches need to be invalidated before
+   the next replot.
+
+   \sa QwtPlotRasterItem::setCachePolicy()
+ */
+void QwtPlotSpectrogram::invalidateCache()
+{
+    QwtPlotRasterItem::invalidateCache();
+    m_data->contourCache.clear();
+}
+
 /*!
    \return Spectrogram data
    \sa setData()
@@ -474,8 +537,8 @@ QRectF QwtPlotSpectrogram::pixelHint( const QRectF& area ) const
    \return A QImage::Format_Indexed8 or QImage::Format_ARGB32 depending
            on the color map.
 
-   \sa QwtRasterData::value(), QwtColorMap::rgb(),
-       QwtColorMap::colorIndex()
+   \sa QwtRasterData::gridValues(), QwtColorMap::rgbRow(),
+       QwtColorMap::colorIndexRow()
  */
 QImage QwtPlotSpectrogram::renderImage(
     const QwtScaleMap& xMap, const QwtScaleMap& yMap,
@@ -579,66 +642,87 @@ void QwtPlotSpectrogram::renderTile(
 
     const bool hasGaps = !m_data->data->testAttribute( QwtRasterData::WithoutGaps );
 
-    if ( m_data->colorMap->format() == QwtColorMap::RGB )
-    {
-        const int numColors = m_data->colorTable.size();
-        const QRgb* rgbTable = m_data->colorTable.constData();
-        const QwtColorMap* colorMap = m_data->colorMap;
+    const QwtRasterData* data = m_data->data;
+    const QwtColorMap* colorMap = m_data->colorMap;
 
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
+    /*
+        The values are requested for bands of rows, so that
+        the raster data can share the row and column specific
+        parts of the resampling. The colors are mapped for complete
+        rows to avoid the overhead of a virtual call per pixel.
+     */
 
-            QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y ) );
-            line += tile.left();
+    const int numColumns = tile.width();
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
+    // the x coordinates are the same for all rows
+    QVector< double > xValues( numColumns );
+    for ( int i = 0; i < numColumns; i++ )
+        xValues[i] = xMap.invTransform( tile.left() + i );
 
-                const double value = m_data->data->value( tx, ty );
+    const int bandHeight = qMin( qwtBandHeight, tile.height() );
 
-                if ( hasGaps && qwtIsNaN( value ) )
-                {
-                    *line++ = 0u;
-                }
-                else if ( numColors == 0 )
-                {
-                    *line++ = colorMap->rgb( range, value );
-                }
-                else
-                {
-                    const uint index = colorMap->colorIndex( numColors, range, value );
-                    *line++ = rgbTable[index];
-                }
-            }
-        }
-    }
-    else if ( m_data->colorMap->format() == QwtColorMap::Indexed )
+    QVector< double > yValues( bandHeight );
+    QVector< double > values( bandHeight * numColumns );
+    QVector< uint > indexes( numColumns );
+
+    const int numColors = m_data->colorTable.size();
+    const QRgb* rgbTable = m_data->colorTable.constData();
+
+    for ( int top = tile.top(); top <= tile.bottom(); top += bandHeight )
     {
-        for ( int y = tile.top(); y <= tile.bottom(); y++ )
-        {
-            const double ty = yMap.invTransform( y );
+        const int numRows = qMin( bandHeight, tile.bottom() - top + 1 );
 
-            unsigned char* line = image->scanLine( y );
-            line += tile.left();
+        for ( int i = 0; i < numRows; i++ )
+            yValues[i] = yMap.invTransform( top + i );
 
-            for ( int x = tile.left(); x <= tile.right(); x++ )
-            {
-                const double tx = xMap.invTransform( x );
+        data->gridValues( xValues.constData(), numColumns,
+            yValues.constData(), numRows, values.data() );
 
-                const double value = m_data->data->value( tx, ty );
+        for ( int i = 0; i < numRows; i++ )
+        {
+            const int y = top + i;
+            const double* rowData = values.constData() + i * numColumns;
+
+            if ( colorMap->format() == QwtColorMap::RGB )
+            {
+                QRgb* line = reinterpret_cast< QRgb* >( image->scanLine( y ) );
+                line += tile.left();
 
-                if ( hasGaps && qwtIsNaN( value ) )
+                if ( numColors == 0 )
                 {
-                    *line++ = 0;
+                    // gaps are mapped to 0u by rgbRow
+                    colorMap->rgbRow( range, rowData, line, numColumns );
                 }
                 else
                 {
-                    const uint index = m_data->colorMap->colorIndex( 256, range, value );
-                    *line++ = static_cast< unsigned char >( index );
+                    colorMap->colorIndexRow( numColors, range,
+                        rowData, indexes.data(), numColumns );
+
+                    for ( int x = 0; x < numColumns; x++ )
+                        line[x] = rgbTable[ indexes[x] ];
+
+                    if ( hasGaps )
+                    {
+                        for ( int x = 0; x < numColumns; x++ )
+                        {
+                            if ( qwtIsNaN( rowData[x] ) )
+                                line[x] = 0u;
+                        }
+                    }
                 }
             }
+            else if ( colorMap->format() == QwtColorMap::Indexed )
+            {
+                // gaps are mapped to 0 by colorIndexRow
+                colorMap->colorIndexRow( 256, range,
+                    rowData, indexes.data(), numColumns );
+
+                unsigned char* line = image->scanLine( y );
+                line += tile.left();
+
+                for ( int x = 0; x < numColumns; x++ )
+                    line[x] = static_cast< unsigned char >( indexes[x] );
+            }
         }
     }
 }
@@ -679,12 +763,15 @@ QSize QwtPlotSpectrogram::contourRasterSize(
 /*!
    Calculate contour lines
 
+   The contour lines are calculated in the number of threads, that
+   has been set by QwtRasterData::setContourThreadCount().
+
    \param rect Rectangle, where to calculate the contour lines
    \param raster Raster, used by the CONREC algorithm
    \return Calculated contour lines
 
    \sa contourLevels(), setConrecFlag(),
-       QwtRasterData::contourLines()
+       QwtRasterData::contourLines(), QwtRasterData::setContourThreadCount()
  */
 QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
     const QRectF& rect, const QSize& raster ) const
@@ -696,6 +783,117 @@ QwtRasterData::ContourLines QwtPlotSpectrogram::renderContourLines(
         m_data->contourLevels, m_data->conrecFlags );
 }
 
+/*!
+   Calculate contour lines using the contour cache
+
+   The contour cache is enabled for all cache policies beside
+   QwtPlotRasterItem::NoCache.
+
+   The raster is divided into tiles of cells, that are anchored at
+   the origin of the scale coordinates. Tiles, that have been calculated
+   for the same resolution before, are taken from the cache, all others
+   are calculated by renderContourLines().
+   So panning a spectrogram only needs to calculate the tiles, that
+   have become visible.
+
+   \param area Rectangle, where to calculate the contour lines
+   \param raster Raster, used by the CONREC algorithm
+   \return Calculated contour lines
+
+   \sa renderContourLines(), invalidateCache()
+ */
+QwtRasterData::ContourLines QwtPlotSpectrogram::cachedContourLines(
+    const QRectF& area, const QSize& raster ) const
+{
+    typedef QPair< qint64, qint64 > TileKey;
+    typedef QMap< TileKey, QwtRasterData::ContourLines > TileMap;
+
+    PrivateData::ContourCache& cache = m_data->contourCache;
+
+    double dx = area.width() / raster.width();
+    double dy = area.height() / raster.height();
+
+    if ( !( dx > 0.0 && dy > 0.0 ) )
+        return renderContourLines( area, raster );
+
+    // panning changes the resolution by rounding errors only
+
+    if ( !( qFuzzyCompare( dx, cache.dx ) && qFuzzyCompare( dy, cache.dy ) ) )
+    {
+        cache.clear();
+        cache.dx = dx;
+        cache.dy = dy;
+    }
+
+    dx = cache.dx;
+    dy = cache.dy;
+
+    const double tileWidth = qwtContourTileSize * dx;
+    const double tileHeight = qwtContourTileSize * dy;
+
+    const double col1 = std::floor( area.left() / tileWidth );
+    const double col2 = std::floor( area.right() / tileWidth );
+    const double row1 = std::floor( area.top() / tileHeight );
+    const double row2 = std::floor( area.bottom() / tileHeight );
+
+    const double limit = 1.0e15;
+    if ( qAbs( col1 ) > limit || qAbs( col2 ) > limit
+        || qAbs( row1 ) > limit || qAbs( row2 ) > limit
+        || ( col2 - col1 + 1 ) * ( row2 - row1 + 1 ) > qwtMaxContourTiles )
+    {
+        // the tiles can't be indexed
+        return renderContourLines( area, raster );
+    }
+
+    const QSize tileRaster( qwtContourTileSize + 1, qwtContourTileSize + 1 );
+
+    QwtRasterData::ContourLines contourLines;
+    QList< TileKey > visibleTiles;
+
+    for ( qint64 row = qint64( row1 ); row <= qint64( row2 ); row++ )
+    {
+        for ( qint64 col = qint64( col1 ); col <= qint64( col2 ); col++ )
+        {
+            const TileKey key( col, row );
+
+            TileMap::const_iterator it = cache.tiles.constFind( key );
+            if ( it == cache.tiles.constEnd() )
+            {
+                // the raster of a tile includes the first
+                // points of its right and bottom neighbours
+
+                const QRectF tileRect( col * tileWidth, row * tileHeight,
+                    ( qwtContourTileSize + 1 ) * dx,
+                    ( qwtContourTileSize + 1 ) * dy );
+
+                it = cache.tiles.insert( key,
+                    renderContourLines( tileRect, tileRaster ) );
+            }
+
+            const QwtRasterData::ContourLines& tileLines = it.value();
+
+            for ( QwtRasterData::ContourLines::const_iterator
+                lines = tileLines.constBegin(); lines != tileLines.constEnd(); ++lines )
+            {
+                contourLines[ lines.key() ] += lines.value();
+            }
+
+            visibleTiles += key;
+        }
+    }
+
+    if ( cache.tiles.size() > qwtMaxContourTiles )
+    {
+        TileMap tiles;
+        for ( int i = 0; i < visibleTiles.size(); i++ )
+            tiles.insert( visibleTiles[i], cache.tiles[ visibleTiles[i] ] );
+
+        cache.tiles = tiles;
+    }
+
+    return contourLines;
+}
+
 /*!
    Paint the contour lines
 
@@ -728,6 +926,30 @@ void QwtPlotSpectrogram::drawContourLines( QPainter* painter,
         painter->setPen( pen );
 
         const QPolygonF& lines = contourLines[level];
+
+        if ( testConrecFlag( QwtRasterData::JoinLines ) )
+        {
+            QPolygonF points( lines.size() );
+            for ( int i = 0; i < lines.size(); i++ )
+            {
+                points[i] = QPointF( xMap.transform( lines[i].x() ),
+                    yMap.transform( lines[i].y() ) );
+            }
+
+            /*
+                The end points of segments from different tiles of
+                the contour cache might differ by rounding errors,
+                what is compensated by a tolerance far below a pixel
+             */
+            const QVector< QPolygonF > polylines =
+                QwtRasterData::joinContourLines( points, 1.0e-3 );
+
+            for ( int i = 0; i < polylines.size(); i++ )
+                QwtPainter::drawPolyline( painter, polylines[i] );
+
+            continue;
+        }
+
         for ( int i = 0; i < lines.size(); i += 2 )
         {
             const QPointF p1( xMap.transform( lines[i].x() ),
@@ -781,8 +1003,17 @@ void QwtPlotSpectrogram::draw( QPainter* painter,
         raster = raster.boundedTo( rasterRect.toRect().size() );
         if ( raster.isValid() )
         {
-            const QwtRasterData::ContourLines lines =
-                renderContourLines( area, raster );
+            QwtRasterData::ContourLines lines;
+
+            {
+                // tiles might be rendered from the same data
+                QMutexLocker locker( renderMutex() );
+
+                if ( cachePolicy() != QwtPlotRasterItem::NoCache )
+                    lines = cachedContourLines( area, raster );
+                else
+                    lines = renderContourLines( area, raster );
+            }
 
             drawContourLines( painter, xMap, yMap, lines );
         }
@@ -84,6 +84,8 @@ class QWT_EXPORT QwtPlotSpectrogram : public QwtPlotRasterItem
     void setContourLevels( const QList< double >& );
     QList< double > contourLevels() const;
 
+    virtual void invalidateCache() QWT_OVERRIDE;
+
     virtual int rtti() const QWT_OVERRIDE;
 
     virtual void draw( QPainter*,
@@ -109,6 +111,9 @@ class QWT_EXPORT QwtPlotSpectrogram : public QwtPlotRasterItem
         const QRect& tile, QImage* ) const;
 
   private:
+    QwtRasterData::ContourLines cachedContourLines(
+        const QRectF&, const QSize& raster ) const;
+
     class PrivateData;
     PrivateData* m_data;
 };
@@ -9,6 +9,8 @@
 
 #include "qwt_point_data.h"
 
+#include <qnumeric.h>
+
 /*!
    Constructor
 
@@ -133,6 +135,22 @@ QPointF QwtSyntheticPointData::sample( size_t index ) const
     return QPointF( xValue, yValue );
 }
 
+/*!
+   Calculate a block of points
+
+   \param from Index of the first point
+   \param count Number of points
+   \param buffer Memory for the points
+
+   \return buffer
+ */
+const QPointF* QwtSyntheticPointData::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    // the points are calculated, there is no array
+    return QwtSeriesData< QPointF >::sampleBlock( from, count, buffer );
+}
+
 /*!
    Calculate a x-value from an index
 
@@ -159,3 +177,335 @@ double QwtSyntheticPointData::x( uint index ) const
     const double dx = interval.width() / ( m_size - 1 );
     return interval.minValue() + index * dx;
 }
+
+namespace
+{
+    class QwtMinMaxNode
+    {
+      public:
+        inline void reset()
+        {
+            minX = minY = qInf();
+            maxX = maxY = -qInf();
+        }
+
+        inline void setPoint( const QPointF& pos )
+        {
+            reset();
+
+            // NaN coordinates are ignored
+
+            if ( pos.x() == pos.x() )
+                minX = maxX = pos.x();
+
+            if ( pos.y() == pos.y() )
+                minY = maxY = pos.y();
+        }
+
+        inline void unite( const QwtMinMaxNode& other )
+        {
+            minX = qMin( minX, other.minX );
+            maxX = qMax( maxX, other.maxX );
+            minY = qMin( minY, other.minY );
+            maxY = qMax( maxY, other.maxY );
+        }
+
+        inline QRectF rect() const
+        {
+            if ( minX > maxX || minY > maxY )
+                return QRectF( 1.0, 1.0, -2.0, -2.0 ); // invalid
+
+            return QRectF( minX, minY, maxX - minX, maxY - minY );
+        }
+
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+    };
+}
+
+class QwtAppendablePointData::PrivateData
+{
+  public:
+    PrivateData()
+        : first( 0 )
+        , maxSize( 0 )
+        , leafCount( 0 )
+    {
+    }
+
+    inline int count() const
+    {
+        return samples.size() - first;
+    }
+
+    void append( const QPointF& );
+    void rebuild();
+    QwtMinMaxNode minMax() const;
+
+    /*
+        The valid samples are [first, samples.size()[. The leafs
+        of the tree correspond to the positions in samples.
+     */
+    QVector< QPointF > samples;
+    int first;
+
+    size_t maxSize;
+
+    int leafCount;
+    QVector< QwtMinMaxNode > tree;
+};
+
+void QwtAppendablePointData::PrivateData::append( const QPointF& pos )
+{
+    if ( samples.size() >= leafCount )
+        rebuild();
+
+    samples += pos;
+
+    int node = leafCount + samples.size() - 1;
+    tree[node].setPoint( pos );
+
+    for ( node >>= 1; node > 0; node >>= 1 )
+    {
+        QwtMinMaxNode& n = tree[node];
+
+        n = tree[2 * node];
+        n.unite( tree[2 * node + 1] );
+    }
+}
+
+void QwtAppendablePointData::PrivateData::rebuild()
+{
+    // dropping the removed samples and growing the tree if necessary
+
+    if ( first > 0 )
+    {
+        samples.remove( 0, first );
+        first = 0;
+    }
+
+    const int minLeafCount = 2 * qMax( samples.size(), 512 );
+
+    if ( leafCount < minLeafCount )
+    {
+        leafCount = minLeafCount;
+        tree.resize( 2 * leafCount );
+    }
+
+    for ( int i = 0; i < leafCount; i++ )
+    {
+        QwtMinMaxNode& leaf = tree[leafCount + i];
+
+        if ( i < samples.size() )
+            leaf.setPoint( samples[i] );
+        else
+            leaf.reset();
+    }
+
+    for ( int node = leafCount - 1; node > 0; node-- )
+    {
+        QwtMinMaxNode& n = tree[node];
+
+        n = tree[2 * node];
+        n.unite( tree[2 * node + 1] );
+    }
+}
+
+QwtMinMaxNode QwtAppendablePointData::PrivateData::minMax() const
+{
+    QwtMinMaxNode result;
+    result.reset();
+
+    /*
+        The leafs behind the last sample might be outdated, but
+        the nodes below the range of valid samples are always
+        up to date, as they have been updated by the last append.
+     */
+    int l = leafCount + first;
+    int r = leafCount + samples.size();
+
+    while ( l < r )
+    {
+        if ( l & 1 )
+            result.unite( tree[l++] );
+
+        if ( r & 1 )
+            result.unite( tree[--r] );
+
+        l >>= 1;
+        r >>= 1;
+    }
+
+    return result;
+}
+
+//! Constructor
+QwtAppendablePointData::QwtAppendablePointData()
+{
+    m_data = new PrivateData;
+}
+
+//! Destructor
+QwtAppendablePointData::~QwtAppendablePointData()
+{
+    delete m_data;
+}
+
+/*!
+   Append a sample
+
+   When a maximum size has been set, the oldest sample is removed,
+   when the series is full.
+
+   \param pos Sample
+   \sa removeFirst(), setMaximumSize()
+ */
+void QwtAppendablePointData::append( const QPointF& pos )
+{
+    if ( m_data->maxSize > 0 && size_t( m_data->count() ) >= m_data->maxSize )
+        removeFirst( m_data->count() - m_data->maxSize + 1 );
+
+    m_data->append( pos );
+
+    if ( cachedBoundingRect.width() >= 0.0 )
+    {
+        // NaN coordinates fail the comparisons
+
+        if ( pos.x() < cachedBoundingRect.left() )
+            cachedBoundingRect.setLeft( pos.x() );
+        else if ( pos.x() > cachedBoundingRect.right() )
+            cachedBoundingRect.setRight( pos.x() );
+
+        if ( pos.y() < cachedBoundingRect.top() )
+            cachedBoundingRect.setTop( pos.y() );
+        else if ( pos.y() > cachedBoundingRect.bottom() )
+            cachedBoundingRect.setBottom( pos.y() );
+    }
+}
+
+/*!
+   Append samples
+
+   \param points Array of samples
+   \param count Number of samples
+ */
+void QwtAppendablePointData::append( const QPointF* points, size_t count )
+{
+    for ( size_t i = 0; i < count; i++ )
+        append( points[i] );
+}
+
+/*!
+   Remove samples from the front
+
+   \param count Number of samples to be removed
+   \sa append(), clear()
+ */
+void QwtAppendablePointData::removeFirst( size_t count )
+{
+    if ( count == 0 )
+        return;
+
+    if ( count >= size_t( m_data->count() ) )
+    {
+        clear();
+        return;
+    }
+
+    m_data->first += static_cast< int >( count );
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+
+    // reclaiming the memory of the removed samples from time to time
+
+    if ( m_data->first > m_data->count() )
+        m_data->rebuild();
+}
+
+//! Remove all samples
+void QwtAppendablePointData::clear()
+{
+    m_data->samples.resize( 0 );
+    m_data->first = 0;
+
+    cachedBoundingRect = QRectF( 0.0, 0.0, -1.0, -1.0 );
+}
+
+/*!
+   Limit the number of samples
+
+   When appending a sample to a full series, the oldest sample
+   gets removed.
+
+   \param size Maximum number of samples, 0 means unlimited
+   \sa maximumSize(), append()
+ */
+void QwtAppendablePointData::setMaximumSize( size_t size )
+{
+    m_data->maxSize = size;
+
+    if ( size > 0 && size_t( m_data->count() ) > size )
+        removeFirst( m_data->count() - size );
+}
+
+/*!
+   \return Maximum number of samples, 0 means unlimited
+   \sa setMaximumSize()
+ */
+size_t QwtAppendablePointData::maximumSize() const
+{
+    return m_data->maxSize;
+}
+
+//! \return Number of samples
+size_t QwtAppendablePointData::size() const
+{
+    return m_data->count();
+}
+
+/*!
+   \return Sample at a specific index
+   \param index Index
+ */
+QPointF QwtAppendablePointData::sample( size_t index ) const
+{
+    return m_data->samples[ m_data->first + static_cast< int >( index ) ];
+}
+
+/*!
+   \brief Access to a block of consecutive samples
+
+   The samples are stored in a contiguous array, so no copy is necessary.
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Unused
+
+   \return Pointer into the array of samples
+ */
+const QPointF* QwtAppendablePointData::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    Q_UNUSED( count )
+    Q_UNUSED( buffer )
+
+    return m_data->samples.constData() + m_data->first + from;
+}
+
+/*!
+   \brief Bounding rectangle of all samples
+
+   The rectangle is extended by append(). After removing samples it
+   is calculated from a tree of the minimum and maximum values
+   in O(log(n)).
+
+   \return Bounding rectangle
+ */
+QRectF QwtAppendablePointData::boundingRect() const
+{
+    if ( cachedBoundingRect.width() < 0.0 )
+        cachedBoundingRect = m_data->minMax().rect();
+
+    return cachedBoundingRect;
+}
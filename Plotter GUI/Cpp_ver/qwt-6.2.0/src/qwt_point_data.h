@@ -28,6 +28,9 @@ class QwtPointArrayData : public QwtPointSeriesData
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
     const QVector< T >& xData() const;
     const QVector< T >& yData() const;
 
@@ -48,6 +51,9 @@ class QwtCPointerData : public QwtPointSeriesData
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
     const T* xData() const;
     const T* yData() const;
 
@@ -73,6 +79,9 @@ class QwtValuePointData : public QwtPointSeriesData
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
     const QVector< T >& yData() const;
 
   private:
@@ -94,6 +103,9 @@ class QwtCPointerValueData : public QwtPointSeriesData
     virtual size_t size() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
     const T* yData() const;
 
   private:
@@ -169,6 +181,9 @@ class QWT_EXPORT QwtSyntheticPointData : public QwtPointSeriesData
     virtual QRectF boundingRect() const QWT_OVERRIDE;
     virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
 
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
     /*!
        Calculate a y value for a x value
 
@@ -188,6 +203,52 @@ class QWT_EXPORT QwtSyntheticPointData : public QwtPointSeriesData
     QwtInterval m_intervalOfInterest;
 };
 
+/*!
+   \brief Point series for live data
+
+   QwtAppendablePointData is a container for samples, that are appended
+   at the end and removed from the front - like the samples of a
+   sliding window in an oscilloscope like display.
+
+   The bounding rectangle is maintained incrementally, so that an
+   autoscaled plot does not have to iterate over all samples, whenever
+   QwtPlotSeriesItem::boundingRect() is requested for a replot.
+   Appending a sample extends the rectangle, after removing samples
+   it is found from a min/max tree in O(log(n)).
+
+   \note The container is owned by the plot item, new samples have
+         to be followed by a replot.
+ */
+class QWT_EXPORT QwtAppendablePointData : public QwtSeriesData< QPointF >
+{
+  public:
+    QwtAppendablePointData();
+    virtual ~QwtAppendablePointData();
+
+    void append( const QPointF& );
+    void append( const QPointF*, size_t count );
+
+    void removeFirst( size_t count );
+    void clear();
+
+    void setMaximumSize( size_t );
+    size_t maximumSize() const;
+
+    virtual size_t size() const QWT_OVERRIDE;
+    virtual QPointF sample( size_t index ) const QWT_OVERRIDE;
+
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+  private:
+    Q_DISABLE_COPY( QwtAppendablePointData )
+
+    class PrivateData;
+    PrivateData* m_data;
+};
+
 /*!
    Constructor
 
@@ -241,6 +302,28 @@ QPointF QwtPointArrayData< T >::sample( size_t index ) const
     return QPointF( m_x[int( index )], m_y[int( index )] );
 }
 
+/*!
+   Copy a block of samples
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Memory for the samples
+
+   \return buffer
+ */
+template< typename T >
+const QPointF* QwtPointArrayData< T >::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    const T* x = m_x.constData() + from;
+    const T* y = m_y.constData() + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        buffer[i] = QPointF( x[i], y[i] );
+
+    return buffer;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const QVector< T >& QwtPointArrayData< T >::xData() const
@@ -301,6 +384,27 @@ QPointF QwtValuePointData< T >::sample( size_t index ) const
     return QPointF( index, m_y[int( index )] );
 }
 
+/*!
+   Copy a block of samples
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Memory for the samples
+
+   \return buffer
+ */
+template< typename T >
+const QPointF* QwtValuePointData< T >::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    const T* y = m_y.constData() + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        buffer[i] = QPointF( from + i, y[i] );
+
+    return buffer;
+}
+
 //! \return Array of the y-values
 template< typename T >
 const QVector< T >& QwtValuePointData< T >::yData() const
@@ -349,6 +453,28 @@ QPointF QwtCPointerData< T >::sample( size_t index ) const
     return QPointF( m_x[int( index )], m_y[int( index )] );
 }
 
+/*!
+   Copy a block of samples
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Memory for the samples
+
+   \return buffer
+ */
+template< typename T >
+const QPointF* QwtCPointerData< T >::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    const T* x = m_x + from;
+    const T* y = m_y + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        buffer[i] = QPointF( x[i], y[i] );
+
+    return buffer;
+}
+
 //! \return Array of the x-values
 template< typename T >
 const T* QwtCPointerData< T >::xData() const
@@ -402,6 +528,27 @@ QPointF QwtCPointerValueData< T >::sample( size_t index ) const
     return QPointF( index, m_y[ int( index ) ] );
 }
 
+/*!
+   Copy a block of samples
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Memory for the samples
+
+   \return buffer
+ */
+template< typename T >
+const QPointF* QwtCPointerValueData< T >::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    const T* y = m_y + from;
+
+    for ( size_t i = 0; i < count; i++ )
+        buffer[i] = QPointF( from + i, y[i] );
+
+    return buffer;
+}
+
 //! \return Array of the y-values
 template< typename T >
 const T* QwtCPointerValueData< T >::yData() const
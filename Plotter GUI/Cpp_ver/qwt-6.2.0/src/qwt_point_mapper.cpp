@@ -12,6 +12,7 @@
 #include "qwt_pixel_matrix.h"
 #include "qwt_series_data.h"
 #include "qwt_math.h"
+#include "qwt_line_rasterizer.h"
 
 #include <qpolygon.h>
 #include <qimage.h>
@@ -28,6 +29,9 @@
 
 static QRectF qwtInvalidRect( 0.0, 0.0, -1.0, -1.0 );
 
+// smaller chunks are not worth to be mapped in another thread
+static const int qwtMinChunkSize = 100000;
+
 static inline int qwtRoundValue( double value )
 {
     return qRound( value );
@@ -79,6 +83,49 @@ static Qt::Orientation qwtProbeOrientation(
 
 namespace
 {
+    /*
+        Reading blocks of samples and mapping them into
+        paint device coordinates
+     */
+    class QwtMappedBlockReader
+    {
+      public:
+        QwtMappedBlockReader( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+                const QwtSeriesData< QPointF >* series, int from, int to )
+            : m_xMap( xMap )
+            , m_yMap( yMap )
+            , m_reader( series, from, to, BlockSize )
+        {
+        }
+
+        inline bool next()
+        {
+            if ( !m_reader.next() )
+                return false;
+
+            if ( m_points.size() < m_reader.count() )
+                m_points.resize( m_reader.count() );
+
+            QwtScaleMap::transform( m_xMap, m_yMap,
+                m_reader.samples(), m_points.data(), m_reader.count() );
+
+            return true;
+        }
+
+        inline int index() const { return m_reader.index(); }
+        inline int count() const { return m_reader.count(); }
+        inline const QPointF* points() const { return m_points.constData(); }
+
+      private:
+        enum { BlockSize = 1024 };
+
+        const QwtScaleMap& m_xMap;
+        const QwtScaleMap& m_yMap;
+
+        QwtSeriesBlockReader< QPointF > m_reader;
+        QVector< QPointF > m_points;
+    };
+
     template< class Polygon, class Point >
     class QwtPolygonQuadrupelX
     {
@@ -194,17 +241,23 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMa
         qwtRoundValue( yMap.transform( sample0.y() ) ) );
 
     Polygon polyline;
-    for ( int i = from; i <= to; i++ )
-    {
-        const QPointF sample = series->sample( i );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+    QwtMappedBlockReader reader( xMap, yMap, series, from, to );
+    while ( reader.next() )
+    {
+        const QPointF* mapped = reader.points();
+        const int count = reader.count();
 
-        if ( !q.append( x, y ) )
+        for ( int i = 0; i < count; i++ )
         {
-            q.flush( polyline );
-            q.start( x, y );
+            const int x = qwtRoundValue( mapped[i].x() );
+            const int y = qwtRoundValue( mapped[i].y() );
+
+            if ( !q.append( x, y ) )
+            {
+                q.flush( polyline );
+                q.start( x, y );
+            }
         }
     }
     q.flush( polyline );
@@ -243,10 +296,65 @@ static Polygon qwtMapPointsQuad( const Polygon& polyline )
     return polylineXY;
 }
 
+template< class Polygon, class Point, class PolygonQuadrupel >
+static Polygon qwtMapPointsQuadThreaded( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to, uint numThreads )
+{
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    const int numChunks = qMin( int( numThreads ), ( to - from + 1 ) / qwtMinChunkSize );
+
+    if ( numChunks > 1 )
+    {
+        typedef Polygon ( *MapFunction )( const QwtScaleMap&, const QwtScaleMap&,
+            const QwtSeriesData< QPointF >*, int, int );
+
+        const MapFunction mapPoints =
+            &qwtMapPointsQuad< Polygon, Point, PolygonQuadrupel >;
+
+        const int chunkSize = ( to - from + 1 ) / numChunks;
+
+        QList< QFuture< Polygon > > futures;
+        for ( int i = 0; i < numChunks - 1; i++ )
+        {
+            const int index0 = from + i * chunkSize;
+
+            futures += QtConcurrent::run( mapPoints,
+                xMap, yMap, series, index0, index0 + chunkSize - 1 );
+        }
+
+        // the last chunk in the current thread
+        const Polygon lastChunk = mapPoints( xMap, yMap,
+            series, from + ( numChunks - 1 ) * chunkSize, to );
+
+        Polygon polyline;
+        for ( int i = 0; i < futures.size(); i++ )
+            polyline += futures[i].result();
+
+        polyline += lastChunk;
+
+        /*
+            A group of points, that has been split at the border between
+            two chunks, ends up as 2 reduced groups. As a reduced group
+            contains the first, last, minimum and maximum of the original
+            points, reducing the joined polyline once more gives
+            the same result as reducing all points in one pass.
+         */
+        return qwtMapPointsQuad< Polygon, Point, PolygonQuadrupel >( polyline );
+    }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    return qwtMapPointsQuad< Polygon, Point, PolygonQuadrupel >(
+        xMap, yMap, series, from, to );
+}
 
 template< class Polygon, class Point >
 static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
-    const QwtSeriesData< QPointF >* series, int from, int to )
+    const QwtSeriesData< QPointF >* series, int from, int to, uint numThreads )
 {
     Polygon polyline;
     if ( from > to )
@@ -260,16 +368,16 @@ static Polygon qwtMapPointsQuad( const QwtScaleMap& xMap, const QwtScaleMap& yMa
 
     if ( orientation == Qt::Horizontal )
     {
-        polyline = qwtMapPointsQuad< Polygon, Point,
-            QwtPolygonQuadrupelY< Polygon, Point > >( xMap, yMap, series, from, to );
+        polyline = qwtMapPointsQuadThreaded< Polygon, Point,
+            QwtPolygonQuadrupelY< Polygon, Point > >( xMap, yMap, series, from, to, numThreads );
 
         polyline = qwtMapPointsQuad< Polygon, Point,
             QwtPolygonQuadrupelX< Polygon, Point > >( polyline );
     }
     else
     {
-        polyline = qwtMapPointsQuad< Polygon, Point,
-            QwtPolygonQuadrupelX< Polygon, Point > >( xMap, yMap, series, from, to );
+        polyline = qwtMapPointsQuadThreaded< Polygon, Point,
+            QwtPolygonQuadrupelX< Polygon, Point > >( xMap, yMap, series, from, to, numThreads );
 
         polyline = qwtMapPointsQuad< Polygon, Point,
             QwtPolygonQuadrupelY< Polygon, Point > >( polyline );
@@ -302,18 +410,179 @@ static void qwtRenderDots(
     const int x0 = pos.x();
     const int y0 = pos.y();
 
-    for ( int i = command.from; i <= command.to; i++ )
+    QwtMappedBlockReader reader( xMap, yMap, command.series, command.from, command.to );
+    while ( reader.next() )
     {
-        const QPointF sample = command.series->sample( i );
+        const QPointF* mapped = reader.points();
+        const int count = reader.count();
 
-        const int x = static_cast< int >( xMap.transform( sample.x() ) + 0.5 ) - x0;
-        const int y = static_cast< int >( yMap.transform( sample.y() ) + 0.5 ) - y0;
+        for ( int i = 0; i < count; i++ )
+        {
+            const int x = static_cast< int >( mapped[i].x() + 0.5 ) - x0;
+            const int y = static_cast< int >( mapped[i].y() + 0.5 ) - y0;
 
-        if ( x >= 0 && x < w && y >= 0 && y < h )
-            bits[ y * w + x ] = rgb;
+            if ( x >= 0 && x < w && y >= 0 && y < h )
+                bits[ y * w + x ] = rgb;
+        }
     }
 }
 
+// Helper class to work around the 5 parameters
+// limitation of QtConcurrent::run()
+class QwtPolylineCommand
+{
+  public:
+    enum StepMode
+    {
+        NoSteps,
+        Steps,
+        InvertedSteps
+    };
+
+    const QwtSeriesData< QPointF >* series;
+    int from;
+    int to;
+
+    QwtPointMapper::TransformationFlags flags;
+    StepMode steps;
+
+    QRectF boundingRect;
+    QPen pen;
+    bool antialiased;
+};
+
+static QPolygonF qwtStepsPolyline( const QPolygonF& points, bool inverted )
+{
+    const int numPoints = points.size();
+    if ( numPoints < 2 )
+        return points;
+
+    QPolygonF polyline( 2 * numPoints - 1 );
+    QPointF* steps = polyline.data();
+
+    steps[0] = points[0];
+
+    for ( int i = 1; i < numPoints; i++ )
+    {
+        const QPointF& p0 = points[i - 1];
+        const QPointF& p = points[i];
+
+        if ( inverted )
+            steps[2 * i - 1] = QPointF( p0.x(), p.y() );
+        else
+            steps[2 * i - 1] = QPointF( p.x(), p0.y() );
+
+        steps[2 * i] = p;
+    }
+
+    return polyline;
+}
+
+static QImage qwtRenderPolyline(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtPolylineCommand& command )
+{
+    const QRect rect = command.boundingRect.toAlignedRect();
+
+    QImage image( rect.size(), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QwtPointMapper mapper;
+    mapper.setFlags( command.flags );
+    mapper.setBoundingRect( command.boundingRect );
+
+    QPolygonF polyline = mapper.toPolygonF(
+        xMap, yMap, command.series, command.from, command.to );
+
+    if ( command.steps != QwtPolylineCommand::NoSteps )
+    {
+        polyline = qwtStepsPolyline( polyline,
+            command.steps == QwtPolylineCommand::InvertedSteps );
+    }
+
+    polyline.translate( -rect.topLeft() );
+
+    const QPen& pen = command.pen;
+
+    if ( pen.style() == Qt::SolidLine
+        && pen.brush().style() == Qt::SolidPattern && pen.widthF() <= 1.0 )
+    {
+        QwtLineRasterizer rasterizer;
+        rasterizer.setColor( pen.color() );
+        rasterizer.setAntialiasing( command.antialiased );
+
+        rasterizer.drawPolyline( image, polyline.constData(), polyline.size() );
+    }
+    else
+    {
+        QPainter painter( &image );
+        painter.setPen( pen );
+        painter.setRenderHint( QPainter::Antialiasing, command.antialiased );
+
+        painter.drawPolyline( polyline );
+    }
+
+    return image;
+}
+
+static QImage qwtRenderPolylineThreaded(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtPolylineCommand& command, uint numThreads )
+{
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    const int numChunks = qMin( int( numThreads ),
+        ( command.to - command.from + 1 ) / qwtMinChunkSize );
+
+    if ( numChunks > 1 )
+    {
+        /*
+            Each chunk is rendered into an image of its own. As the last
+            point of a chunk is the first point of the next one, the
+            chunks are connected and the images are composed in the
+            order of the series.
+         */
+
+        const int chunkSize = ( command.to - command.from + 1 ) / numChunks;
+
+        QwtPolylineCommand chunkCommand = command;
+
+        QList< QFuture< QImage > > futures;
+        for ( int i = 0; i < numChunks - 1; i++ )
+        {
+            chunkCommand.from = command.from + i * chunkSize;
+            chunkCommand.to = chunkCommand.from + chunkSize;
+
+            futures += QtConcurrent::run( &qwtRenderPolyline,
+                xMap, yMap, chunkCommand );
+        }
+
+        // the last chunk in the current thread
+        chunkCommand.from = command.from + ( numChunks - 1 ) * chunkSize;
+        chunkCommand.to = command.to;
+
+        const QImage lastChunk = qwtRenderPolyline( xMap, yMap, chunkCommand );
+
+        QImage image = futures[0].result();
+
+        QPainter painter( &image );
+        for ( int i = 1; i < futures.size(); i++ )
+            painter.drawImage( 0, 0, futures[i].result() );
+
+        painter.drawImage( 0, 0, lastChunk );
+        painter.end();
+
+        return image;
+    }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    return qwtRenderPolyline( xMap, yMap, command );
+}
+
 // some functors, so that the compile can inline
 struct QwtRoundI
 {
@@ -339,6 +608,173 @@ struct QwtNoRoundF
     }
 };
 
+namespace
+{
+    /*
+        First, minimum, maximum and last y coordinate of
+        consecutive points in the same pixel column
+     */
+    class QwtColumnMinMax
+    {
+      public:
+        inline void start( double x, double y )
+        {
+            x0 = x;
+            y1 = yMin = yMax = y2 = y;
+        }
+
+        inline bool append( double x, double y )
+        {
+            if ( x0 != x )
+                return false;
+
+            if ( y < yMin )
+                yMin = y;
+            else if ( y > yMax )
+                yMax = y;
+
+            y2 = y;
+
+            return true;
+        }
+
+        inline void flush( QPolygonF& polyline )
+        {
+            polyline += QPointF( x0, y1 );
+
+            if ( y2 > y1 )
+                qSwap( yMin, yMax );
+
+            if ( yMax != y1 )
+                polyline += QPointF( x0, yMax );
+
+            if ( yMin != yMax )
+                polyline += QPointF( x0, yMin );
+
+            if ( y2 != yMin )
+                polyline += QPointF( x0, y2 );
+        }
+
+      private:
+        double x0, y1, yMin, yMax, y2;
+    };
+}
+
+template< class Round >
+static QPolygonF qwtMapColumns( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to )
+{
+    const Round round;
+
+    const QPointF sample0 = series->sample( from );
+
+    QwtColumnMinMax column;
+    column.start( qwtRoundValueF( xMap.transform( sample0.x() ) ),
+        round( yMap.transform( sample0.y() ) ) );
+
+    QPolygonF polyline;
+
+    QwtMappedBlockReader reader( xMap, yMap, series, from, to );
+    while ( reader.next() )
+    {
+        const QPointF* mapped = reader.points();
+        const int count = reader.count();
+
+        for ( int i = 0; i < count; i++ )
+        {
+            const double x = qwtRoundValueF( mapped[i].x() );
+            const double y = round( mapped[i].y() );
+
+            if ( !column.append( x, y ) )
+            {
+                column.flush( polyline );
+                column.start( x, y );
+            }
+        }
+    }
+    column.flush( polyline );
+
+    return polyline;
+}
+
+static QPolygonF qwtMapColumns( const QPolygonF& polyline )
+{
+    const int numPoints = polyline.size();
+
+    if ( numPoints < 3 )
+        return polyline;
+
+    const QPointF* points = polyline.constData();
+
+    QPolygonF reduced;
+
+    QwtColumnMinMax column;
+    column.start( points[0].x(), points[0].y() );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        if ( !column.append( points[i].x(), points[i].y() ) )
+        {
+            column.flush( reduced );
+            column.start( points[i].x(), points[i].y() );
+        }
+    }
+    column.flush( reduced );
+
+    return reduced;
+}
+
+template< class Round >
+static QPolygonF qwtMapColumnsThreaded( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to, uint numThreads )
+{
+    if ( from > to )
+        return QPolygonF();
+
+#if QWT_USE_THREADS
+    if ( numThreads == 0 )
+        numThreads = QThread::idealThreadCount();
+
+    const int numChunks = qMin( int( numThreads ), ( to - from + 1 ) / qwtMinChunkSize );
+
+    if ( numChunks > 1 )
+    {
+        typedef QPolygonF ( *MapFunction )( const QwtScaleMap&, const QwtScaleMap&,
+            const QwtSeriesData< QPointF >*, int, int );
+
+        const MapFunction mapPoints = &qwtMapColumns< Round >;
+
+        const int chunkSize = ( to - from + 1 ) / numChunks;
+
+        QList< QFuture< QPolygonF > > futures;
+        for ( int i = 0; i < numChunks - 1; i++ )
+        {
+            const int index0 = from + i * chunkSize;
+
+            futures += QtConcurrent::run( mapPoints,
+                xMap, yMap, series, index0, index0 + chunkSize - 1 );
+        }
+
+        // the last chunk in the current thread
+        const QPolygonF lastChunk = mapPoints( xMap, yMap,
+            series, from + ( numChunks - 1 ) * chunkSize, to );
+
+        QPolygonF polyline;
+        for ( int i = 0; i < futures.size(); i++ )
+            polyline += futures[i].result();
+
+        polyline += lastChunk;
+
+        // a column, that has been split between 2 chunks, is joined again
+        return qwtMapColumns( polyline );
+    }
+#else
+    Q_UNUSED( numThreads )
+#endif
+
+    return qwtMapColumns< Round >( xMap, yMap, series, from, to );
+}
+
 // mapping points without any filtering - beside checking
 // the bounding rectangle
 
@@ -354,25 +790,31 @@ static inline Polygon qwtToPoints(
 
     int numPoints = 0;
 
+    QwtMappedBlockReader reader( xMap, yMap, series, from, to );
+
     if ( boundingRect.isValid() )
     {
         // iterating over all values
         // filtering out all points outside of
         // the bounding rectangle
 
-        for ( int i = from; i <= to; i++ )
+        while ( reader.next() )
         {
-            const QPointF sample = series->sample( i );
-
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            const QPointF* mapped = reader.points();
+            const int count = reader.count();
 
-            if ( boundingRect.contains( x, y ) )
+            for ( int i = 0; i < count; i++ )
             {
-                points[ numPoints ].rx() = round( x );
-                points[ numPoints ].ry() = round( y );
+                const double x = mapped[i].x();
+                const double y = mapped[i].y();
 
-                numPoints++;
+                if ( boundingRect.contains( x, y ) )
+                {
+                    points[ numPoints ].rx() = round( x );
+                    points[ numPoints ].ry() = round( y );
+
+                    numPoints++;
+                }
             }
         }
 
@@ -383,17 +825,21 @@ static inline Polygon qwtToPoints(
         // simply iterating over all values
         // without any filtering
 
-        for ( int i = from; i <= to; i++ )
+        while ( reader.next() )
         {
-            const QPointF sample = series->sample( i );
+            const QPointF* mapped = reader.points();
+            const int count = reader.count();
 
-            const double x = xMap.transform( sample.x() );
-            const double y = yMap.transform( sample.y() );
+            for ( int i = 0; i < count; i++ )
+            {
+                const double x = mapped[i].x();
+                const double y = mapped[i].y();
 
-            points[ numPoints ].rx() = round( x );
-            points[ numPoints ].ry() = round( y );
+                points[ numPoints ].rx() = round( x );
+                points[ numPoints ].ry() = round( y );
 
-            numPoints++;
+                numPoints++;
+            }
         }
     }
 
@@ -444,15 +890,21 @@ static inline Polygon qwtToPolylineFiltered(
     points[0].ry() = round( yMap.transform( sample0.y() ) );
 
     int pos = 0;
-    for ( int i = from + 1; i <= to; i++ )
+
+    QwtMappedBlockReader reader( xMap, yMap, series, from + 1, to );
+    while ( reader.next() )
     {
-        const QPointF sample = series->sample( i );
+        const QPointF* mapped = reader.points();
+        const int count = reader.count();
 
-        const Point p( round( xMap.transform( sample.x() ) ),
-            round( yMap.transform( sample.y() ) ) );
+        for ( int i = 0; i < count; i++ )
+        {
+            const Point p( round( mapped[i].x() ),
+                round( mapped[i].y() ) );
 
-        if ( points[pos] != p )
-            points[++pos] = p;
+            if ( points[pos] != p )
+                points[++pos] = p;
+        }
     }
 
     polyline.resize( pos + 1 );
@@ -493,19 +945,25 @@ static inline Polygon qwtToPointsFiltered(
     QwtPixelMatrix pixelMatrix( boundingRect.toAlignedRect() );
 
     int numPoints = 0;
-    for ( int i = from; i <= to; i++ )
-    {
-        const QPointF sample = series->sample( i );
 
-        const int x = qwtRoundValue( xMap.transform( sample.x() ) );
-        const int y = qwtRoundValue( yMap.transform( sample.y() ) );
+    QwtMappedBlockReader reader( xMap, yMap, series, from, to );
+    while ( reader.next() )
+    {
+        const QPointF* mapped = reader.points();
+        const int count = reader.count();
 
-        if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+        for ( int i = 0; i < count; i++ )
         {
-            points[ numPoints ].rx() = x;
-            points[ numPoints ].ry() = y;
+            const int x = qwtRoundValue( mapped[i].x() );
+            const int y = qwtRoundValue( mapped[i].y() );
+
+            if ( pixelMatrix.testAndSetPixel( x, y, true ) == false )
+            {
+                points[ numPoints ].rx() = x;
+                points[ numPoints ].ry() = y;
 
-            numPoints++;
+                numPoints++;
+            }
         }
     }
 
@@ -536,11 +994,13 @@ class QwtPointMapper::PrivateData
   public:
     PrivateData()
         : boundingRect( qwtInvalidRect )
+        , numThreads( 1 )
     {
     }
 
     QRectF boundingRect;
     QwtPointMapper::TransformationFlags flags;
+    uint numThreads;
 };
 
 //! Constructor
@@ -623,6 +1083,36 @@ QRectF QwtPointMapper::boundingRect() const
     return m_data->boundingRect;
 }
 
+/*!
+   Set the number of threads for mapping points
+
+   Large series are split into chunks, that are mapped in parallel.
+   So far this is implemented for the WeedOutIntermediatePoints
+   algorithm of toPolygon() and toPolygonF() and for MinMaxColumns only.
+
+   \param numThreads Number of threads. If numThreads is set to 0,
+                     the system specific ideal thread count is used.
+                     The default setting is 1 ( = no additional threads ).
+
+   \note The series has to support concurrent calls of
+         QwtSeriesData::sampleBlock()
+   \sa threadCount(), toImage()
+ */
+void QwtPointMapper::setThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads for mapping points, where 0 means
+           the system specific ideal thread count.
+   \sa setThreadCount()
+ */
+uint QwtPointMapper::threadCount() const
+{
+    return m_data->numThreads;
+}
+
 /*!
    \brief Translate a series of points into a QPolygonF
 
@@ -636,6 +1126,10 @@ QRectF QwtPointMapper::boundingRect() const
    When RoundPoints & WeedOutIntermediatePoints is enabled an even more
    aggressive weeding algorithm is enabled.
 
+   When MinMaxColumns is enabled the x coordinates are rounded to
+   pixel columns and each chunk of consecutive points in the same
+   column is reduced to 4 points.
+
    \param xMap x map
    \param yMap y map
    \param series Series of points to be mapped
@@ -650,12 +1144,25 @@ QPolygonF QwtPointMapper::toPolygonF(
 {
     QPolygonF polyline;
 
-    if ( m_data->flags & RoundPoints )
+    if ( m_data->flags & MinMaxColumns )
+    {
+        if ( m_data->flags & RoundPoints )
+        {
+            polyline = qwtMapColumnsThreaded< QwtRoundF >(
+                xMap, yMap, series, from, to, threadCount() );
+        }
+        else
+        {
+            polyline = qwtMapColumnsThreaded< QwtNoRoundF >(
+                xMap, yMap, series, from, to, threadCount() );
+        }
+    }
+    else if ( m_data->flags & RoundPoints )
     {
         if ( m_data->flags & WeedOutIntermediatePoints )
         {
             polyline = qwtMapPointsQuad< QPolygonF, QPointF >(
-                xMap, yMap, series, from, to );
+                xMap, yMap, series, from, to, threadCount() );
         }
         else if ( m_data->flags & WeedOutPoints )
         {
@@ -709,7 +1216,7 @@ QPolygon QwtPointMapper::toPolygon(
     {
         // TODO WeedOutIntermediatePointsY ...
         polyline = qwtMapPointsQuad< QPolygon, QPoint >(
-            xMap, yMap, series, from, to );
+            xMap, yMap, series, from, to, threadCount() );
     }
     else if ( m_data->flags & WeedOutPoints )
     {
@@ -967,3 +1474,92 @@ QImage QwtPointMapper::toImage(
 
     return image;
 }
+
+/*!
+   \brief Render a series as polyline into a QImage
+
+   The series is mapped like in toPolygonF() - respecting the flags() -
+   and the lines are rendered into an image of the size of the
+   boundingRect(). Solid pens with a width of one pixel are rasterized
+   by QwtLineRasterizer, all others are painted by QPainter.
+
+   For huge series the lines can be rendered by several threads, where each
+   thread maps and renders a chunk of the series into an image of its own.
+   The images are composed in the order of the series.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param pen Pen used for drawing the lines
+   \param antialiased True, when the lines should be displayed
+                     antialiased
+   \param numThreads Number of threads to be used for rendering.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \return Image displaying the series
+
+   \note As each chunk is painted separately a dash pattern
+         restarts at the borders between the chunks.
+   \sa toStepsImage(), toImage()
+ */
+QImage QwtPointMapper::toPolylineImage(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    const QPen& pen, bool antialiased, uint numThreads ) const
+{
+    QwtPolylineCommand command;
+    command.series = series;
+    command.from = from;
+    command.to = to;
+    command.flags = m_data->flags;
+    command.steps = QwtPolylineCommand::NoSteps;
+    command.boundingRect = m_data->boundingRect;
+    command.pen = pen;
+    command.antialiased = antialiased;
+
+    return qwtRenderPolylineThreaded( xMap, yMap, command, numThreads );
+}
+
+/*!
+   \brief Render a series as steps into a QImage
+
+   Like toPolylineImage(), but connecting the points by a horizontal and
+   a vertical line. Beside RoundPoints the flags() are ignored.
+
+   \param xMap x map
+   \param yMap y map
+   \param series Series of points to be mapped
+   \param from Index of the first point to be painted
+   \param to Index of the last point to be painted
+   \param inverted When true, the vertical line is drawn first
+   \param pen Pen used for drawing the lines
+   \param antialiased True, when the lines should be displayed
+                     antialiased
+   \param numThreads Number of threads to be used for rendering.
+                   If numThreads is set to 0, the system specific
+                   ideal thread count is used.
+
+   \return Image displaying the series
+   \sa toPolylineImage(), QwtPlotCurve::Steps
+ */
+QImage QwtPointMapper::toStepsImage(
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QwtSeriesData< QPointF >* series, int from, int to,
+    bool inverted, const QPen& pen, bool antialiased, uint numThreads ) const
+{
+    QwtPolylineCommand command;
+    command.series = series;
+    command.from = from;
+    command.to = to;
+    command.flags = m_data->flags & RoundPoints;
+    command.steps = inverted
+        ? QwtPolylineCommand::InvertedSteps : QwtPolylineCommand::Steps;
+    command.boundingRect = m_data->boundingRect;
+    command.pen = pen;
+    command.antialiased = antialiased;
+
+    return qwtRenderPolylineThreaded( xMap, yMap, command, numThreads );
+}
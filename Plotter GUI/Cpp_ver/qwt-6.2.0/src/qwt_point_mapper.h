@@ -65,7 +65,26 @@ class QWT_EXPORT QwtPointMapper
            As the algorithm is fast it can be used inside of
            a polyline render cycle.
          */
-        WeedOutIntermediatePoints = 0x04
+        WeedOutIntermediatePoints = 0x04,
+
+        /*!
+           An "oscilloscope" mode for toPolygonF(), where the
+           x coordinates are rounded to pixel columns, while the y
+           coordinates are rounded only, when RoundPoints is set.
+
+           Like in WeedOutIntermediatePoints each chunk of consecutive
+           points in the same column is reduced to the first, minimum,
+           maximum and last point, but without depending on
+           RoundPoints and in one pass for series with increasing
+           x coordinates. So the number of points is limited by
+           4 times the width.
+
+           As the polyline still passes all pixels of the column,
+           that had been passed by the original polyline, drawing
+           it with an opaque, aliased pen of one pixel gives the same
+           result as drawing all points with rounded coordinates.
+         */
+        MinMaxColumns = 0x08
     };
 
     Q_DECLARE_FLAGS( TransformationFlags, TransformationFlag )
@@ -82,6 +101,9 @@ class QWT_EXPORT QwtPointMapper
     void setBoundingRect( const QRectF& );
     QRectF boundingRect() const;
 
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
     QPolygonF toPolygonF( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
         const QwtSeriesData< QPointF >* series, int from, int to ) const;
 
@@ -98,6 +120,14 @@ class QWT_EXPORT QwtPointMapper
         const QwtSeriesData< QPointF >* series, int from, int to,
         const QPen&, bool antialiased, uint numThreads ) const;
 
+    QImage toPolylineImage( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to,
+        const QPen&, bool antialiased, uint numThreads ) const;
+
+    QImage toStepsImage( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+        const QwtSeriesData< QPointF >* series, int from, int to,
+        bool inverted, const QPen&, bool antialiased, uint numThreads ) const;
+
   private:
     Q_DISABLE_COPY(QwtPointMapper)
 
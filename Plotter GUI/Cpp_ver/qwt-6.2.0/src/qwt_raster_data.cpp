@@ -16,6 +16,13 @@
 #include <qnumeric.h>
 #include <qlist.h>
 #include <qmap.h>
+#include <qvector.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <algorithm>
+#include <cmath>
 
 class QwtRasterData::ContourPlane
 {
@@ -164,7 +171,13 @@ inline QPointF QwtRasterData::ContourPlane::intersection(
 class QwtRasterData::PrivateData
 {
   public:
+    PrivateData()
+        : contourThreadCount( 1 )
+    {
+    }
+
     QwtRasterData::Attributes attributes;
+    uint contourThreadCount;
 };
 
 //! Constructor
@@ -203,6 +216,31 @@ bool QwtRasterData::testAttribute( Attribute attribute ) const
     return m_data->attributes & attribute;
 }
 
+/*!
+   Set the number of threads, that are used by contourLines()
+
+   For numThreads != 1 gridValues() is called from parallel threads
+   and has to be thread safe.
+
+   \param numThreads Number of threads, 0 means the system specific
+                     ideal thread count. The default setting is 1.
+
+   \sa contourThreadCount(), contourLines()
+ */
+void QwtRasterData::setContourThreadCount( uint numThreads )
+{
+    m_data->contourThreadCount = numThreads;
+}
+
+/*!
+   \return Number of threads, that are used by contourLines()
+   \sa setContourThreadCount()
+ */
+uint QwtRasterData::contourThreadCount() const
+{
+    return m_data->contourThreadCount;
+}
+
 /*!
    \brief Initialize a raster
 
@@ -271,98 +309,142 @@ QRectF QwtRasterData::pixelHint( const QRectF& area ) const
 }
 
 /*!
-   Calculate contour lines
+   \brief Values of a row of raster positions
 
-   \param rect Bounding rectangle for the contour lines
-   \param raster Number of data pixels of the raster data
-   \param levels List of limits, where to insert contour lines
-   \param flags Flags to customize the contouring algorithm
+   Rendering an image requests the values for all pixels of a row,
+   where y is the same for all positions. Implementations, that
+   can calculate the row specific part of the resampling once,
+   or avoid the overhead of calling value() for each pixel,
+   should reimplement rowValues().
 
-   \return Calculated contour lines
+   The default implementation calls value() for each position.
 
-   An adaption of CONREC, a simple contouring algorithm.
-   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+   \param x Array of x values in plot coordinates
+   \param y Y value in plot coordinates
+   \param values Array for the values, at least count elements
+   \param count Number of positions
+
+   \sa value()
  */
-QwtRasterData::ContourLines QwtRasterData::contourLines(
-    const QRectF& rect, const QSize& raster,
-    const QList< double >& levels, ConrecFlags flags ) const
+void QwtRasterData::rowValues( const double* x, double y,
+    double* values, int count ) const
 {
-    ContourLines contourLines;
+    for ( int i = 0; i < count; i++ )
+        values[i] = value( x[i], y );
+}
 
-    if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
-        return contourLines;
+/*!
+   \brief Values of a grid of raster positions
 
-    const double dx = rect.width() / raster.width();
-    const double dy = rect.height() / raster.height();
+   QwtPlotSpectrogram requests the values for bands of rows. Resampling
+   algorithms, that can share calculations between the rows - like
+   separable interpolations - should reimplement gridValues().
 
-    const bool ignoreOnPlane =
-        flags & QwtRasterData::IgnoreAllVerticesOnLevel;
+   The default implementation calls rowValues() for each row.
 
-    const QwtInterval range = interval( Qt::ZAxis );
-    bool ignoreOutOfRange = false;
-    if ( range.isValid() )
-        ignoreOutOfRange = flags & IgnoreOutOfRange;
+   \param x Array of numColumns x values in plot coordinates
+   \param numColumns Number of columns of the grid
+   \param y Array of numRows y values in plot coordinates
+   \param numRows Number of rows of the grid
+   \param values Array for numColumns * numRows values, row by row
 
-    QwtRasterData* that = const_cast< QwtRasterData* >( this );
-    that->initRaster( rect, raster );
+   \sa rowValues(), value()
+ */
+void QwtRasterData::gridValues( const double* x, int numColumns,
+    const double* y, int numRows, double* values ) const
+{
+    for ( int i = 0; i < numRows; i++ )
+        rowValues( x, y[i], values + i * numColumns, numColumns );
+}
 
-    for ( int y = 0; y < raster.height() - 1; y++ )
+namespace
+{
+    class QwtContourBand
     {
-        enum Position
-        {
-            Center,
+      public:
+        const QwtRasterData* data;
 
-            TopLeft,
-            TopRight,
-            BottomRight,
-            BottomLeft,
+        const double* xValues;
+        int numColumns;
 
-            NumPositions
-        };
+        double y0;
+        double dy;
+        int firstRow;
+        int numRows;
 
-        QwtPoint3D xy[NumPositions];
+        const QList< double >* levels;
+        QwtInterval range;
+        bool ignoreOutOfRange;
+        bool ignoreOnPlane;
 
-        for ( int x = 0; x < raster.width() - 1; x++ )
-        {
-            const QPointF pos( rect.x() + x * dx, rect.y() + y * dy );
+        // line segments for each index of levels
+        QVector< QPolygonF > lines;
+    };
+}
 
-            if ( x == 0 )
-            {
-                xy[TopRight].setX( pos.x() );
-                xy[TopRight].setY( pos.y() );
-                xy[TopRight].setZ(
-                    value( xy[TopRight].x(), xy[TopRight].y() )
-                    );
-
-                xy[BottomRight].setX( pos.x() );
-                xy[BottomRight].setY( pos.y() + dy );
-                xy[BottomRight].setZ(
-                    value( xy[BottomRight].x(), xy[BottomRight].y() )
-                    );
-            }
+static void qwtContourBand( QwtContourBand* band )
+{
+    enum Position
+    {
+        Center,
+
+        TopLeft,
+        TopRight,
+        BottomRight,
+        BottomLeft,
 
-            xy[TopLeft] = xy[TopRight];
-            xy[BottomLeft] = xy[BottomRight];
+        NumPositions
+    };
+
+    const QList< double >& levels = *band->levels;
+    const int numLevels = levels.size();
+
+    band->lines.resize( numLevels );
 
-            xy[TopRight].setX( pos.x() + dx );
-            xy[TopRight].setY( pos.y() );
-            xy[BottomRight].setX( pos.x() + dx );
-            xy[BottomRight].setY( pos.y() + dy );
+    const int numColumns = band->numColumns;
+    const double* x = band->xValues;
+
+    /*
+        The values of a band are requested in one go. The bottom row
+        of the band is the top row of the next band and is requested
+        twice, but the rows of the raster are not shared between
+        the threads.
+     */
 
-            xy[TopRight].setZ(
-                value( xy[TopRight].x(), xy[TopRight].y() )
-                );
-            xy[BottomRight].setZ(
-                value( xy[BottomRight].x(), xy[BottomRight].y() )
-                );
+    const int numPointRows = band->numRows + 1;
+
+    QVector< double > yValues( numPointRows );
+    for ( int j = 0; j < numPointRows; j++ )
+        yValues[j] = band->y0 + ( band->firstRow + j ) * band->dy;
+
+    QVector< double > zValues( numPointRows * numColumns );
+    band->data->gridValues( x, numColumns,
+        yValues.constData(), numPointRows, zValues.data() );
+
+    QwtPoint3D xy[NumPositions];
+
+    for ( int j = 0; j < band->numRows; j++ )
+    {
+        const double yTop = yValues[j];
+        const double yBottom = yValues[j + 1];
+
+        const double* zTop = zValues.constData() + j * numColumns;
+        const double* zBottom = zTop + numColumns;
+
+        for ( int i = 0; i < numColumns - 1; i++ )
+        {
+            xy[TopLeft] = QwtPoint3D( x[i], yTop, zTop[i] );
+            xy[TopRight] = QwtPoint3D( x[i + 1], yTop, zTop[i + 1] );
+            xy[BottomRight] = QwtPoint3D( x[i + 1], yBottom, zBottom[i + 1] );
+            xy[BottomLeft] = QwtPoint3D( x[i], yBottom, zBottom[i] );
 
             double zMin = xy[TopLeft].z();
             double zMax = zMin;
             double zSum = zMin;
 
-            for ( int i = TopRight; i <= BottomLeft; i++ )
+            for ( int k = TopRight; k <= BottomLeft; k++ )
             {
-                const double z = xy[i].z();
+                const double z = xy[k].z();
 
                 zSum += z;
                 if ( z < zMin )
@@ -377,30 +459,27 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
                 continue;
             }
 
-            if ( ignoreOutOfRange )
+            if ( band->ignoreOutOfRange )
             {
-                if ( !range.contains( zMin ) || !range.contains( zMax ) )
+                if ( !band->range.contains( zMin ) || !band->range.contains( zMax ) )
                     continue;
             }
 
-            if ( zMax < levels[0] ||
-                zMin > levels[levels.size() - 1] )
-            {
+            if ( zMax < levels[0] || zMin > levels[numLevels - 1] )
                 continue;
-            }
 
-            xy[Center].setX( pos.x() + 0.5 * dx );
-            xy[Center].setY( pos.y() + 0.5 * dy );
+            xy[Center].setX( 0.5 * ( x[i] + x[i + 1] ) );
+            xy[Center].setY( 0.5 * ( yTop + yBottom ) );
             xy[Center].setZ( 0.25 * zSum );
 
-            const int numLevels = levels.size();
             for ( int l = 0; l < numLevels; l++ )
             {
                 const double level = levels[l];
                 if ( level < zMin || level > zMax )
                     continue;
-                QPolygonF& lines = contourLines[level];
-                const ContourPlane plane( level );
+
+                QPolygonF& lines = band->lines[l];
+                const QwtRasterData::ContourPlane plane( level );
 
                 QPointF line[2];
                 QwtPoint3D vertex[3];
@@ -412,7 +491,7 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
                     vertex[2] = xy[m != BottomLeft ? m + 1 : TopLeft];
 
                     const bool intersects =
-                        plane.intersect( vertex, line, ignoreOnPlane );
+                        plane.intersect( vertex, line, band->ignoreOnPlane );
                     if ( intersects )
                     {
                         lines += line[0];
@@ -422,8 +501,260 @@ QwtRasterData::ContourLines QwtRasterData::contourLines(
             }
         }
     }
+}
+
+/*!
+   Calculate contour lines
+
+   \param rect Bounding rectangle for the contour lines
+   \param raster Number of data pixels of the raster data
+   \param levels List of limits, where to insert contour lines
+   \param flags Flags to customize the contouring algorithm
+
+   \return Calculated contour lines
+
+   An adaption of CONREC, a simple contouring algorithm.
+   http://local.wasp.uwa.edu.au/~pbourke/papers/conrec/
+
+   The values of the raster are requested with gridValues(). For
+   contourThreadCount() != 1 the raster is divided into bands of rows,
+   that are processed in parallel threads. Then gridValues() has to be
+   thread safe.
+   The line segments of the bands are appended in the order of the rows,
+   so that the result does not depend on the number of threads.
+
+   \note QwtRasterData::JoinLines has no effect on the result. Joining
+         the segments is done by joinContourLines().
+ */
+QwtRasterData::ContourLines QwtRasterData::contourLines(
+    const QRectF& rect, const QSize& raster,
+    const QList< double >& levels, ConrecFlags flags ) const
+{
+    ContourLines contourLines;
+
+    if ( levels.size() == 0 || !rect.isValid() || !raster.isValid() )
+        return contourLines;
+
+    const int numColumns = raster.width();
+    const int numRows = raster.height() - 1;
+
+    if ( numColumns < 2 || numRows < 1 )
+        return contourLines;
+
+    const double dx = rect.width() / raster.width();
+    const double dy = rect.height() / raster.height();
+
+    const QwtInterval range = interval( Qt::ZAxis );
+
+    QVector< double > xValues( numColumns );
+    for ( int i = 0; i < numColumns; i++ )
+        xValues[i] = rect.x() + i * dx;
+
+#if !defined( QT_NO_QFUTURE )
+    uint numThreads = m_data->contourThreadCount;
+    if ( numThreads == 0 )
+        numThreads = qMax( QThread::idealThreadCount(), 1 );
+#else
+    const uint numThreads = 1;
+#endif
+
+    // bands with less rows are not worth a thread
+    const int minRowsPerBand = 16;
+    const int numBands = qBound( 1, numRows / minRowsPerBand, int( numThreads ) );
+
+    QVector< QwtContourBand > bands( numBands );
+    for ( int i = 0; i < numBands; i++ )
+    {
+        QwtContourBand& band = bands[i];
+
+        band.data = this;
+        band.xValues = xValues.constData();
+        band.numColumns = numColumns;
+        band.y0 = rect.y();
+        band.dy = dy;
+        band.firstRow = i * numRows / numBands;
+        band.numRows = ( i + 1 ) * numRows / numBands - band.firstRow;
+        band.levels = &levels;
+        band.range = range;
+        band.ignoreOutOfRange = range.isValid() && ( flags & IgnoreOutOfRange );
+        band.ignoreOnPlane = flags & IgnoreAllVerticesOnLevel;
+    }
+
+    QwtRasterData* that = const_cast< QwtRasterData* >( this );
+    that->initRaster( rect, raster );
+
+#if !defined( QT_NO_QFUTURE )
+    QVector< QFuture< void > > futures;
+    futures.reserve( numBands - 1 );
+
+    for ( int i = 0; i < numBands - 1; i++ )
+        futures += QtConcurrent::run( &qwtContourBand, &bands[i] );
+
+    qwtContourBand( &bands[numBands - 1] );
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#else
+    qwtContourBand( &bands[0] );
+#endif
 
     that->discardRaster();
 
+    for ( int i = 0; i < numBands; i++ )
+    {
+        const QVector< QPolygonF >& lines = bands[i].lines;
+
+        for ( int l = 0; l < lines.size(); l++ )
+        {
+            if ( !lines[l].isEmpty() )
+                contourLines[ levels[l] ] += lines[l];
+        }
+    }
+
     return contourLines;
 }
+
+namespace
+{
+    class QwtLineEnd
+    {
+      public:
+        inline bool operator<( const QwtLineEnd& other ) const
+        {
+            if ( x != other.x )
+                return x < other.x;
+
+            return y < other.y;
+        }
+
+        inline bool operator==( const QwtLineEnd& other ) const
+        {
+            return x == other.x && y == other.y;
+        }
+
+        double x;
+        double y;
+        int index; // index of the point in the segments
+    };
+}
+
+/*!
+   \brief Join line segments to polylines
+
+   contourLines() returns the contour lines of a level as unordered
+   line segments: each pair of points is a line. As the segments of
+   neighboured raster cells share their end points, they can be joined
+   to continuous polylines, what is much faster to paint and gives
+   proper joins and dash patterns for wide or styled pens.
+
+   Closed contours result in polylines, where the first and the last point
+   are the same.
+
+   \param lines Line segments, as returned by contourLines()
+   \param tolerance Maximum distance in x or y direction between end points,
+                    that are considered to be the same. For a tolerance
+                    of 0.0 end points have to be identical.
+
+   \return Polylines
+   \sa contourLines(), QwtRasterData::JoinLines
+ */
+QVector< QPolygonF > QwtRasterData::joinContourLines(
+    const QPolygonF& lines, double tolerance )
+{
+    const int numSegments = lines.size() / 2;
+
+    QVector< QwtLineEnd > ends;
+    ends.reserve( 2 * numSegments );
+
+    for ( int i = 0; i < 2 * numSegments; i += 2 )
+    {
+        // zero length segments can't be joined in a meaningful way
+        if ( lines[i] == lines[i + 1] )
+            continue;
+
+        for ( int k = i; k <= i + 1; k++ )
+        {
+            QwtLineEnd end;
+            end.x = lines[k].x();
+            end.y = lines[k].y();
+            end.index = k;
+
+            if ( tolerance > 0.0 )
+            {
+                end.x = std::floor( end.x / tolerance + 0.5 );
+                end.y = std::floor( end.y / tolerance + 0.5 );
+            }
+
+            ends += end;
+        }
+    }
+
+    std::sort( ends.begin(), ends.end() );
+
+    // index of the end point, that is connected, or -1
+
+    QVector< int > partner( 2 * numSegments, -1 );
+
+    for ( int i = 0; i + 1 < ends.size(); )
+    {
+        if ( ends[i] == ends[i + 1] )
+        {
+            partner[ ends[i].index ] = ends[i + 1].index;
+            partner[ ends[i + 1].index ] = ends[i].index;
+
+            i += 2;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    QVector< QPolygonF > polylines;
+    QVector< bool > done( numSegments, false );
+
+    for ( int i = 0; i < numSegments; i++ )
+    {
+        if ( done[i] || lines[2 * i] == lines[2 * i + 1] )
+            continue;
+
+        // walking backwards to the start of the polyline
+
+        int start = 2 * i;
+        while ( partner[start] >= 0 )
+        {
+            const int index = partner[start] ^ 1;
+            if ( index == 2 * i )
+                break; // closed polyline
+
+            start = index;
+        }
+
+        // walking forward, collecting the points
+
+        QPolygonF polyline;
+        polyline += lines[start];
+
+        int index = start;
+        for ( ;; )
+        {
+            const int segment = index / 2;
+            if ( done[segment] )
+                break;
+
+            done[segment] = true;
+
+            const int other = index ^ 1;
+            polyline += lines[other];
+
+            if ( partner[other] < 0 )
+                break;
+
+            index = partner[other];
+        }
+
+        polylines += polyline;
+    }
+
+    return polylines;
+}
@@ -18,6 +18,7 @@ class QPolygonF;
 class QRectF;
 class QSize;
 template< typename T > class QList;
+template< typename T > class QVector;
 template< class Key, class T > class QMap;
 
 /*!
@@ -80,7 +81,14 @@ class QWT_EXPORT QwtRasterData
         IgnoreAllVerticesOnLevel = 0x01,
 
         //! Ignore all values, that are out of range
-        IgnoreOutOfRange = 0x02
+        IgnoreOutOfRange = 0x02,
+
+        /*!
+           Join the line segments to polylines before painting them
+
+           \sa joinContourLines(), QwtPlotSpectrogram::drawContourLines()
+         */
+        JoinLines = 0x04
     };
 
     Q_DECLARE_FLAGS( ConrecFlags, ConrecFlag )
@@ -91,6 +99,9 @@ class QWT_EXPORT QwtRasterData
     void setAttribute( Attribute, bool on = true );
     bool testAttribute( Attribute ) const;
 
+    void setContourThreadCount( uint numThreads );
+    uint contourThreadCount() const;
+
     /*!
        \return Bounding interval for an axis
        \sa setInterval
@@ -109,10 +120,19 @@ class QWT_EXPORT QwtRasterData
      */
     virtual double value( double x, double y ) const = 0;
 
+    virtual void rowValues( const double* x, double y,
+        double* values, int count ) const;
+
+    virtual void gridValues( const double* x, int numColumns,
+        const double* y, int numRows, double* values ) const;
+
     virtual ContourLines contourLines( const QRectF& rect,
         const QSize& raster, const QList< double >& levels,
         ConrecFlags ) const;
 
+    static QVector< QPolygonF > joinContourLines(
+        const QPolygonF& lines, double tolerance = 0.0 );
+
     class Contour3DPoint;
     class ContourPlane;
 
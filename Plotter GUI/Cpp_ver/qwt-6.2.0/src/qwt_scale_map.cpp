@@ -13,6 +13,84 @@
 #include <qrect.h>
 #include <qdebug.h>
 
+#if defined( __AVX__ )
+#define QWT_SCALE_MAP_AVX 1
+#include <immintrin.h>
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+    ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define QWT_SCALE_MAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined( __ARM_NEON ) && defined( __aarch64__ )
+#define QWT_SCALE_MAP_NEON 1
+#include <arm_neon.h>
+#endif
+
+/*
+   The linear part of the transformation: p1 + ( s - ts1 ) * cnv
+
+   Even and odd indices might belong to different maps, what is the
+   case for the interleaved coordinates of an array of QPointF.
+   Values and result might be the same array.
+ */
+static void qwtTransformLinear( const double* values, double* result,
+    int count, const double ts1[2], const double cnv[2], const double p1[2] )
+{
+    int i = 0;
+
+#if QWT_SCALE_MAP_AVX
+    {
+        const __m256d s = _mm256_setr_pd( ts1[0], ts1[1], ts1[0], ts1[1] );
+        const __m256d f = _mm256_setr_pd( cnv[0], cnv[1], cnv[0], cnv[1] );
+        const __m256d p = _mm256_setr_pd( p1[0], p1[1], p1[0], p1[1] );
+
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            const __m256d v = _mm256_loadu_pd( values + i );
+            _mm256_storeu_pd( result + i,
+                _mm256_add_pd( p, _mm256_mul_pd( _mm256_sub_pd( v, s ), f ) ) );
+        }
+    }
+#endif
+
+#if QWT_SCALE_MAP_SSE2
+    {
+        const __m128d s = _mm_setr_pd( ts1[0], ts1[1] );
+        const __m128d f = _mm_setr_pd( cnv[0], cnv[1] );
+        const __m128d p = _mm_setr_pd( p1[0], p1[1] );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const __m128d v = _mm_loadu_pd( values + i );
+            _mm_storeu_pd( result + i,
+                _mm_add_pd( p, _mm_mul_pd( _mm_sub_pd( v, s ), f ) ) );
+        }
+    }
+#elif QWT_SCALE_MAP_NEON
+    {
+        const float64x2_t s = vld1q_f64( ts1 );
+        const float64x2_t f = vld1q_f64( cnv );
+        const float64x2_t p = vld1q_f64( p1 );
+
+        for ( ; i + 2 <= count; i += 2 )
+        {
+            const float64x2_t v = vld1q_f64( values + i );
+            vst1q_f64( result + i,
+                vaddq_f64( p, vmulq_f64( vsubq_f64( v, s ), f ) ) );
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ )
+    {
+        const int k = i & 1;
+        result[i] = p1[k] + ( values[i] - ts1[k] ) * cnv[k];
+    }
+}
+
 /*!
    \brief Constructor
 
@@ -175,6 +253,87 @@ QRectF QwtScaleMap::transform( const QwtScaleMap& xMap,
     return QRectF( x1, y1, x2 - x1 + 1, y2 - y1 + 1 );
 }
 
+/*!
+   Transform an array of values from scale to paint coordinates
+
+   The result is the same as calling transform() for each value,
+   but the linear part of the transformation is done with
+   SIMD instructions ( SSE2/AVX or NEON ), when available.
+   Non linear transformations, like QwtLogTransform, are
+   applied value by value before.
+
+   \param values Values relative to the coordinates of the scale
+   \param result Transformed values, might be the same array as values
+   \param count Number of values
+ */
+void QwtScaleMap::transform( const double* values, double* result, int count ) const
+{
+    if ( m_transform )
+    {
+        for ( int i = 0; i < count; i++ )
+            result[i] = m_transform->transform( values[i] );
+
+        values = result;
+    }
+
+    const double ts1[2] = { m_ts1, m_ts1 };
+    const double cnv[2] = { m_cnv, m_cnv };
+    const double p1[2] = { m_p1, m_p1 };
+
+    qwtTransformLinear( values, result, count, ts1, cnv, p1 );
+}
+
+/*!
+   Transform an array of points from scale to paint coordinates
+
+   The result is the same as calling transform() for each point,
+   but the linear part of the transformation is done with
+   SIMD instructions ( SSE2/AVX or NEON ), when available.
+
+   \param xMap X map
+   \param yMap Y map
+   \param points Points in scale coordinates
+   \param result Points in paint coordinates, might be the same array as points
+   \param count Number of points
+ */
+void QwtScaleMap::transform( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QPointF* points, QPointF* result, int count )
+{
+    if ( sizeof( QPointF ) != 2 * sizeof( double ) )
+    {
+        // qreal is float
+        for ( int i = 0; i < count; i++ )
+            result[i] = transform( xMap, yMap, points[i] );
+
+        return;
+    }
+
+    if ( xMap.m_transform || yMap.m_transform )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            double x = points[i].x();
+            if ( xMap.m_transform )
+                x = xMap.m_transform->transform( x );
+
+            double y = points[i].y();
+            if ( yMap.m_transform )
+                y = yMap.m_transform->transform( y );
+
+            result[i] = QPointF( x, y );
+        }
+
+        points = result;
+    }
+
+    const double ts1[2] = { xMap.m_ts1, yMap.m_ts1 };
+    const double cnv[2] = { xMap.m_cnv, yMap.m_cnv };
+    const double p1[2] = { xMap.m_p1, yMap.m_p1 };
+
+    qwtTransformLinear( reinterpret_cast< const double* >( points ),
+        reinterpret_cast< double* >( result ), 2 * count, ts1, cnv, p1 );
+}
+
 /*!
    Transform a rectangle from paint to scale coordinates
 
@@ -233,6 +392,29 @@ QRectF QwtScaleMap::invTransform( const QwtScaleMap& xMap,
     return r.normalized();
 }
 
+/*!
+   \brief Compare the mapping of two maps
+
+   The maps are the same, when they have the same intervals and their
+   transformations map a value in the middle of the scale interval
+   to the same position. So copies of a map are always the same,
+   even if the transformation objects are different.
+
+   \param other Other map
+   \return True, when both maps are mapping values the same way
+ */
+bool QwtScaleMap::isSameMapping( const QwtScaleMap& other ) const
+{
+    if ( m_s1 != other.m_s1 || m_s2 != other.m_s2
+        || m_p1 != other.m_p1 || m_p2 != other.m_p2 )
+    {
+        return false;
+    }
+
+    const double s = 0.5 * ( m_s1 + m_s2 );
+    return transform( s ) == other.transform( s );
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 QDebug operator<<( QDebug debug, const QwtScaleMap& map )
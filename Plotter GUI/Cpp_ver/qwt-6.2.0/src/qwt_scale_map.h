@@ -42,6 +42,8 @@ class QWT_EXPORT QwtScaleMap
     double transform( double s ) const;
     double invTransform( double p ) const;
 
+    void transform( const double* values, double* result, int count ) const;
+
     double p1() const;
     double p2() const;
 
@@ -63,7 +65,11 @@ class QWT_EXPORT QwtScaleMap
     static QPointF invTransform( const QwtScaleMap&,
         const QwtScaleMap&, const QPointF& );
 
+    static void transform( const QwtScaleMap&, const QwtScaleMap&,
+        const QPointF* points, QPointF* result, int count );
+
     bool isInverting() const;
+    bool isSameMapping( const QwtScaleMap& ) const;
 
   private:
     void updateFactor();
@@ -10,6 +10,8 @@
 #include "qwt_series_data.h"
 #include "qwt_point_polar.h"
 
+#include <typeinfo>
+
 static inline QRectF qwtBoundingRect( const QPointF& sample )
 {
     return QRectF( sample.x(), sample.y(), 0.0, 0.0 );
@@ -95,27 +97,32 @@ QRectF qwtBoundingRectT( const QwtSeriesData< T >& series, int from, int to )
     if ( to < from )
         return boundingRect;
 
-    int i;
-    for ( i = from; i <= to; i++ )
-    {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
-        if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
-        {
-            boundingRect = rect;
-            i++;
-            break;
-        }
-    }
+    bool isValid = false;
 
-    for ( ; i <= to; i++ )
+    QwtSeriesBlockReader< T > reader( &series, from, to );
+    while ( reader.next() )
     {
-        const QRectF rect = qwtBoundingRect( series.sample( i ) );
-        if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
+        const T* samples = reader.samples();
+        const int count = reader.count();
+
+        for ( int i = 0; i < count; i++ )
         {
-            boundingRect.setLeft( qMin( boundingRect.left(), rect.left() ) );
-            boundingRect.setRight( qMax( boundingRect.right(), rect.right() ) );
-            boundingRect.setTop( qMin( boundingRect.top(), rect.top() ) );
-            boundingRect.setBottom( qMax( boundingRect.bottom(), rect.bottom() ) );
+            const QRectF rect = qwtBoundingRect( samples[i] );
+            if ( rect.width() >= 0.0 && rect.height() >= 0.0 )
+            {
+                if ( isValid )
+                {
+                    boundingRect.setLeft( qMin( boundingRect.left(), rect.left() ) );
+                    boundingRect.setRight( qMax( boundingRect.right(), rect.right() ) );
+                    boundingRect.setTop( qMin( boundingRect.top(), rect.top() ) );
+                    boundingRect.setBottom( qMax( boundingRect.bottom(), rect.bottom() ) );
+                }
+                else
+                {
+                    boundingRect = rect;
+                    isValid = true;
+                }
+            }
         }
     }
 
@@ -268,6 +275,28 @@ QRectF QwtPointSeriesData::boundingRect() const
     return cachedBoundingRect;
 }
 
+/*!
+   \brief Access to a block of consecutive samples
+
+   The samples are stored in a contiguous array, so no copy is necessary.
+   As derived classes might reimplement sample() without reading
+   the array, they fall back to the default implementation.
+
+   \param from Index of the first sample
+   \param count Number of samples
+   \param buffer Memory for at least count samples
+
+   \return Pointer to count samples starting at from
+ */
+const QPointF* QwtPointSeriesData::sampleBlock(
+    size_t from, size_t count, QPointF* buffer ) const
+{
+    if ( typeid( *this ) != typeid( QwtPointSeriesData ) )
+        return QwtArraySeriesData< QPointF >::sampleBlock( from, count, buffer );
+
+    return m_samples.constData() + from;
+}
+
 /*!
    Constructor
    \param samples Samples
@@ -101,6 +101,29 @@ class QwtSeriesData
      */
     virtual void setRectOfInterest( const QRectF& rect );
 
+    /*!
+       Access to a block of consecutive samples
+
+       Algorithms iterating over many samples - like mapping the points
+       of a curve - can avoid the overhead of calling the virtual sample()
+       for each index by fetching the samples in blocks.
+
+       Implementations, that store their samples in a contiguous array of T,
+       return a pointer into their own memory. Others copy the samples
+       into buffer and return buffer.
+
+       The default implementation copies the result of sample()
+       into the buffer.
+
+       \param from Index of the first sample
+       \param count Number of samples
+       \param buffer Memory for at least count samples
+
+       \return Pointer to count samples starting at from
+       \sa QwtSeriesBlockReader
+     */
+    virtual const T* sampleBlock( size_t from, size_t count, T* buffer ) const;
+
   protected:
     //! Can be used to cache a calculated bounding rectangle
     mutable QRectF cachedBoundingRect;
@@ -125,6 +148,109 @@ void QwtSeriesData< T >::setRectOfInterest( const QRectF& )
 {
 }
 
+template< typename T >
+const T* QwtSeriesData< T >::sampleBlock(
+    size_t from, size_t count, T* buffer ) const
+{
+    for ( size_t i = 0; i < count; i++ )
+        buffer[i] = sample( from + i );
+
+    return buffer;
+}
+
+/*!
+   \brief Iterating over the samples of a series in blocks
+
+   QwtSeriesBlockReader fetches the samples with QwtSeriesData::sampleBlock(),
+   what costs one virtual call for a block of samples instead of one
+   for each sample.
+
+   \code
+    QwtSeriesBlockReader< QPointF > reader( series, from, to );
+    while ( reader.next() )
+    {
+        const QPointF* samples = reader.samples();
+        for ( int i = 0; i < reader.count(); i++ )
+            doSomething( reader.index() + i, samples[i] );
+    }
+   \endcode
+ */
+template< typename T >
+class QwtSeriesBlockReader
+{
+  public:
+    QwtSeriesBlockReader( const QwtSeriesData< T >* series,
+        int from, int to, int blockSize = 1024 );
+
+    bool next();
+
+    //! \return Index of the first sample of the current block
+    int index() const { return m_index; }
+
+    //! \return Number of samples of the current block
+    int count() const { return m_count; }
+
+    //! \return Samples of the current block
+    const T* samples() const { return m_samples; }
+
+  private:
+    const QwtSeriesData< T >* m_series;
+
+    int m_index;
+    int m_count;
+    int m_to;
+    int m_blockSize;
+
+    const T* m_samples;
+    QVector< T > m_buffer;
+};
+
+/*!
+   Constructor
+
+   \param series Series
+   \param from Index of the first sample, < 0 means from the beginning
+   \param to Index of the last sample, < 0 means to the end
+   \param blockSize Maximum number of samples of a block
+ */
+template< typename T >
+QwtSeriesBlockReader< T >::QwtSeriesBlockReader(
+        const QwtSeriesData< T >* series, int from, int to, int blockSize )
+    : m_series( series )
+    , m_index( qMax( from, 0 ) )
+    , m_count( 0 )
+    , m_to( to )
+    , m_blockSize( qMax( blockSize, 1 ) )
+    , m_samples( NULL )
+{
+    if ( m_to < 0 )
+        m_to = static_cast< int >( series->size() ) - 1;
+}
+
+/*!
+   Fetch the next block of samples
+
+   \return false, when all samples have been read
+ */
+template< typename T >
+bool QwtSeriesBlockReader< T >::next()
+{
+    m_index += m_count;
+    if ( m_index > m_to )
+    {
+        m_count = 0;
+        return false;
+    }
+
+    m_count = qMin( m_blockSize, m_to - m_index + 1 );
+
+    if ( m_buffer.size() < m_count )
+        m_buffer.resize( m_count );
+
+    m_samples = m_series->sampleBlock( m_index, m_count, m_buffer.data() );
+    return true;
+}
+
 /*!
    \brief Template class for data, that is organized as QVector
 
@@ -205,7 +331,14 @@ T QwtArraySeriesData< T >::sample( size_t i ) const
     return m_samples[ static_cast< int >( i ) ];
 }
 
-//! Interface for iterating over an array of points
+/*!
+   \brief Interface for iterating over an array of points
+
+   \note sampleBlock() returns a pointer into the array of points
+         for QwtPointSeriesData objects only. For derived classes
+         the samples are copied from sample(), unless they
+         reimplement sampleBlock() themselves.
+ */
 class QWT_EXPORT QwtPointSeriesData : public QwtArraySeriesData< QPointF >
 {
   public:
@@ -213,6 +346,9 @@ class QWT_EXPORT QwtPointSeriesData : public QwtArraySeriesData< QPointF >
         const QVector< QPointF >& = QVector< QPointF >( ) );
 
     virtual QRectF boundingRect() const QWT_OVERRIDE;
+
+    virtual const QPointF* sampleBlock( size_t from,
+        size_t count, QPointF* buffer ) const QWT_OVERRIDE;
 };
 
 //! Interface for iterating over an array of 3D points
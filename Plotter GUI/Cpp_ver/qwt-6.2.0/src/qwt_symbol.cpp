@@ -15,7 +15,11 @@
 #include <qpainter.h>
 #include <qpainterpath.h>
 #include <qpixmap.h>
+#include <qimage.h>
 #include <qpaintengine.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
 #ifndef QWT_NO_SVG
 #include <qsvgrenderer.h>
 #endif
@@ -767,6 +771,265 @@ static inline void qwtDrawHexagonSymbols( QPainter* painter,
     }
 }
 
+// less sprites are painted one by one
+static const int qwtMinSprites = 100;
+
+// less sprites are not worth a thread
+static const int qwtMinSpritesPerThread = 10000;
+
+static inline qreal qwtDevicePixelRatio( const QPaintDevice* device )
+{
+#if QT_VERSION >= 0x050600
+    return device->devicePixelRatioF();
+#elif QT_VERSION >= 0x050000
+    return device->devicePixelRatio();
+#else
+    Q_UNUSED( device )
+    return 1.0;
+#endif
+}
+
+// the same rounding as the raster paint engine
+static inline uint qwtByteMul( uint x, uint a )
+{
+    uint t = ( x & 0xff00ff ) * a;
+    t = ( t + ( ( t >> 8 ) & 0xff00ff ) + 0x800080 ) >> 8;
+    t &= 0xff00ff;
+
+    x = ( ( x >> 8 ) & 0xff00ff ) * a;
+    x = ( x + ( ( x >> 8 ) & 0xff00ff ) + 0x800080 );
+    x &= 0xff00ff00;
+
+    return x | t;
+}
+
+namespace
+{
+    // the pixels of the target, without detaching it in the threads
+    class QwtSpriteTarget
+    {
+      public:
+        explicit QwtSpriteTarget( QImage* image )
+            : bits( image->bits() )
+            , bytesPerLine( image->bytesPerLine() )
+            , opaqueMask( image->format() == QImage::Format_RGB32 ? 0xff000000u : 0u )
+        {
+        }
+
+        inline uint* scanLine( int y ) const
+        {
+            return reinterpret_cast< uint* >( bits + y * bytesPerLine );
+        }
+
+        uchar* bits;
+        int bytesPerLine;
+        uint opaqueMask;
+    };
+}
+
+static void qwtStampSpriteBand( const QwtSpriteTarget* target, const QImage* sprite,
+    const QPoint* positions, int numPoints, const QRect& clipRect )
+{
+    // source over of premultiplied pixels
+
+    const uint opaqueMask = target->opaqueMask;
+
+    const QSize spriteSize = sprite->size();
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const QPoint& pos = positions[i];
+
+        const QRect r = QRect( pos, spriteSize ) & clipRect;
+        if ( r.isEmpty() )
+            continue;
+
+        const int x0 = r.left() - pos.x();
+        const int w = r.width();
+
+        for ( int y = r.top(); y <= r.bottom(); y++ )
+        {
+            const uint* src = reinterpret_cast< const uint* >(
+                sprite->constScanLine( y - pos.y() ) ) + x0;
+
+            uint* dst = target->scanLine( y ) + r.left();
+
+            for ( int x = 0; x < w; x++ )
+            {
+                const uint s = src[x];
+                const uint alpha = s >> 24;
+
+                if ( alpha == 255 )
+                    dst[x] = s;
+                else if ( s != 0 )
+                    dst[x] = ( s + qwtByteMul( dst[x], 255 - alpha ) ) | opaqueMask;
+            }
+        }
+    }
+}
+
+static void qwtStampSprites( QImage* image, const QImage* sprite,
+    const QVector< QPoint >& positions, const QRect& clipRect )
+{
+    const int numPoints = positions.size();
+    const QwtSpriteTarget target( image );
+
+    int numThreads = 1;
+#if !defined( QT_NO_QFUTURE )
+    numThreads = qBound( 1, numPoints / qwtMinSpritesPerThread,
+        qMax( QThread::idealThreadCount(), 1 ) );
+
+    numThreads = qMin( numThreads, clipRect.height() );
+#endif
+
+    if ( numThreads <= 1 )
+    {
+        qwtStampSpriteBand( &target, sprite,
+            positions.constData(), numPoints, clipRect );
+        return;
+    }
+
+#if !defined( QT_NO_QFUTURE )
+    /*
+        Each thread composites all sprites, but only into its band
+        of rows. So the threads don't write to the same pixels
+        and the sprites overlap in the order of the points.
+     */
+
+    const int top = clipRect.top();
+    const int height = clipRect.height();
+
+    QVector< QFuture< void > > futures;
+    futures.reserve( numThreads - 1 );
+
+    for ( int i = 0; i < numThreads; i++ )
+    {
+        const int y1 = top + i * height / numThreads;
+        const int y2 = top + ( i + 1 ) * height / numThreads;
+
+        const QRect band( clipRect.left(), y1, clipRect.width(), y2 - y1 );
+
+        if ( i == numThreads - 1 )
+        {
+            qwtStampSpriteBand( &target, sprite,
+                positions.constData(), numPoints, band );
+        }
+        else
+        {
+            futures += QtConcurrent::run(
+                &qwtStampSpriteBand, &target, sprite,
+                positions.constData(), numPoints, band );
+        }
+    }
+
+    for ( int i = 0; i < futures.size(); i++ )
+        futures[i].waitForFinished();
+#endif
+}
+
+static void qwtDrawSprites( QPainter* painter, const QImage& sprite,
+    const QPointF& offset, qreal ratio, const QPointF* points, int numPoints )
+{
+    const QTransform transform = painter->transform();
+
+    if ( numPoints < qwtMinSprites )
+    {
+        // the overhead of compositing is not worth it
+
+        painter->save();
+        painter->resetTransform();
+
+        const QSizeF size( sprite.width() / ratio, sprite.height() / ratio );
+
+        for ( int i = 0; i < numPoints; i++ )
+        {
+            const QPointF pos = transform.map( points[i] ) * ratio + offset;
+
+            const QPointF topLeft( qRound( pos.x() ) / ratio,
+                qRound( pos.y() ) / ratio );
+
+            painter->drawImage( QRectF( topLeft, size ), sprite );
+        }
+
+        painter->restore();
+        return;
+    }
+
+    QVector< QPoint > positions( numPoints );
+
+    QRect boundingRect;
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const QPointF pos = transform.map( points[i] ) * ratio + offset;
+        positions[i] = QPoint( qRound( pos.x() ), qRound( pos.y() ) );
+
+        boundingRect |= QRect( positions[i], sprite.size() );
+    }
+
+    QPaintDevice* device = painter->device();
+
+    QRect clipRect;
+    if ( device->devType() == QInternal::Image )
+    {
+        clipRect = static_cast< QImage* >( device )->rect();
+    }
+    else
+    {
+        clipRect.setRect( 0, 0, qwtCeil( device->width() * ratio ),
+            qwtCeil( device->height() * ratio ) );
+    }
+
+    bool isRectClip = true;
+    if ( painter->hasClipping() )
+    {
+        const QRegion clipRegion = painter->clipRegion();
+        isRectClip = clipRegion.rectCount() <= 1;
+
+        const QRectF r = transform.mapRect( QRectF( clipRegion.boundingRect() ) );
+        clipRect &= QRectF( r.topLeft() * ratio, r.size() * ratio ).toAlignedRect();
+    }
+
+    clipRect &= boundingRect;
+    if ( clipRect.isEmpty() )
+        return;
+
+    if ( device->devType() == QInternal::Image && isRectClip
+        && painter->opacity() == 1.0
+        && painter->compositionMode() == QPainter::CompositionMode_SourceOver )
+    {
+        QImage* image = static_cast< QImage* >( device );
+
+        if ( image->isDetached() &&
+            ( image->format() == QImage::Format_ARGB32_Premultiplied
+            || image->format() == QImage::Format_RGB32 ) )
+        {
+            // compositing into the pixels of the target image
+            qwtStampSprites( image, &sprite, positions, clipRect );
+            return;
+        }
+    }
+
+    // compositing into an intermediate image, that is painted in one go
+
+    QImage layer( clipRect.size(), QImage::Format_ARGB32_Premultiplied );
+    layer.fill( 0 );
+
+    for ( int i = 0; i < numPoints; i++ )
+        positions[i] -= clipRect.topLeft();
+
+    qwtStampSprites( &layer, &sprite, positions, layer.rect() );
+
+    painter->save();
+    painter->resetTransform();
+
+    const QRectF targetRect( clipRect.x() / ratio, clipRect.y() / ratio,
+        clipRect.width() / ratio, clipRect.height() / ratio );
+
+    painter->drawImage( targetRect, layer );
+
+    painter->restore();
+}
+
 class QwtSymbol::PrivateData
 {
   public:
@@ -779,6 +1042,7 @@ class QwtSymbol::PrivateData
         , isPinPointEnabled( false )
     {
         cache.policy = QwtSymbol::AutoCache;
+        cache.spriteRatio = 1.0;
 #ifndef QWT_NO_SVG
         svg.renderer = NULL;
 #endif
@@ -830,6 +1094,9 @@ class QwtSymbol::PrivateData
         QwtSymbol::CachePolicy policy;
         QPixmap pixmap;
 
+        QImage sprite;
+        qreal spriteRatio;
+
     } cache;
 };
 
@@ -1318,7 +1585,8 @@ void QwtSymbol::drawSymbols( QPainter* painter,
     if ( QwtPainter::roundingAlignment( painter ) &&
         !painter->transform().isScaling() )
     {
-        if ( m_data->cache.policy == QwtSymbol::Cache )
+        if ( m_data->cache.policy == QwtSymbol::Cache
+            || m_data->cache.policy == QwtSymbol::SpriteCache )
         {
             useCache = true;
         }
@@ -1383,7 +1651,37 @@ void QwtSymbol::drawSymbols( QPainter* painter,
         }
     }
 
-    if ( useCache )
+    if ( useCache && m_data->cache.policy == QwtSymbol::SpriteCache )
+    {
+        const QRect br = boundingRect();
+        const qreal ratio = qwtDevicePixelRatio( painter->device() );
+
+        if ( m_data->cache.sprite.isNull() || m_data->cache.spriteRatio != ratio )
+        {
+            QImage sprite( qwtCeil( br.width() * ratio ),
+                qwtCeil( br.height() * ratio ), QImage::Format_ARGB32_Premultiplied );
+            sprite.fill( 0 );
+
+            QPainter p( &sprite );
+            p.setRenderHints( painter->renderHints() );
+            p.scale( ratio, ratio );
+            p.translate( -br.topLeft() );
+
+            const QPointF pos( 0.0, 0.0 );
+            renderSymbols( &p, &pos, 1 );
+
+            p.end();
+
+            m_data->cache.sprite = sprite;
+            m_data->cache.spriteRatio = ratio;
+        }
+
+        const QPointF offset( br.left() * ratio, br.top() * ratio );
+
+        qwtDrawSprites( painter, m_data->cache.sprite,
+            offset, ratio, points, numPoints );
+    }
+    else if ( useCache )
     {
         const QRect br = boundingRect();
 
@@ -1771,6 +2069,9 @@ void QwtSymbol::invalidateCache()
 {
     if ( !m_data->cache.pixmap.isNull() )
         m_data->cache.pixmap = QPixmap();
+
+    if ( !m_data->cache.sprite.isNull() )
+        m_data->cache.sprite = QImage();
 }
 
 /*!
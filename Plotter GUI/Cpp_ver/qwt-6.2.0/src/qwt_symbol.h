@@ -161,7 +161,20 @@ class QWT_EXPORT QwtSymbol
            - The symbol is rendered with the software
              renderer ( QPaintEngine::Raster )
          */
-        AutoCache
+        AutoCache,
+
+        /*!
+           The symbol is rendered once to an image in device resolution.
+           Large numbers of symbols are composited by the CPU - in
+           parallel threads - directly into the target, when painting
+           to a QImage, or into an intermediate image, that is painted
+           with a single call. The positions are rounded to device pixels
+           like with Cache.
+
+           This policy is intended for scatter plots with many thousands
+           of symbols.
+         */
+        SpriteCache
     };
 
   public:
@@ -12,34 +12,347 @@
 
 #include <qpainterpath.h>
 #include <qpolygon.h>
-#include <qstack.h>
 #include <qvector.h>
+#include <qthread.h>
+#include <qfuture.h>
+#include <qtconcurrentrun.h>
+
+#include <cstring>
+
+#if !defined( QT_NO_QFUTURE )
+#define QWT_USE_THREADS 1
+#endif
+
+// less points are not worth to be simplified in another thread
+static const int qwtMinPointsPerThread = 10000;
+
+class QwtWeedingCurveFitter::Line
+{
+  public:
+    Line( int i1 = 0, int i2 = 0 )
+        : from( i1 )
+        , to( i2 )
+    {
+    }
+
+    int from;
+    int to;
+};
 
 class QwtWeedingCurveFitter::PrivateData
 {
   public:
+    /*
+        Buffers, that are reused for all runs of the algorithm
+        to avoid allocations for each replot. They never shrink.
+     */
+    class Scratch
+    {
+      public:
+        QVector< Line > stack;
+        QVector< int > indices;
+    };
+
+    // Helper class to work around the 5 parameters
+    // limitation of QtConcurrent::run()
+    class ChunkJob
+    {
+      public:
+        const QPointF* points;
+        int from;
+        int to;
+        int chunkSize;
+        double toleranceSqr;
+        Scratch* scratch;
+    };
+
     PrivateData()
         : tolerance( 1.0 )
         , chunkSize( 0 )
+        , numThreads( 1 )
+        , streaming( false )
+        , streamAnchor( 0 )
     {
     }
 
+    static int simplify( const QPointF*, int numPoints,
+        double toleranceSqr, Scratch& );
+
+    static QPolygonF simplifyChunks( const ChunkJob& );
+
+    QPolygonF fitChunks( const QPolygonF& );
+    QPolygonF fitStream( const QPolygonF& );
+
     double tolerance;
     uint chunkSize;
+    uint numThreads;
+
+    Scratch scratch;
+    QVector< Scratch > threadScratch;
+
+    bool streaming;
+
+    // input of the previous run and the frozen part of its result
+    QPolygonF streamInput;
+    QPolygonF streamFitted;
+    int streamAnchor;
 };
 
-class QwtWeedingCurveFitter::Line
+/*
+   Iterative implementation of the Douglas Peucker algorithm.
+
+   The indices of the points to be kept are written in increasing
+   order to scratch.indices, the number of them is returned. Pushing
+   the right half of a split line before the left one makes the
+   accepted lines being popped from left to right.
+ */
+int QwtWeedingCurveFitter::PrivateData::simplify( const QPointF* p,
+    int nPoints, double toleranceSqr, Scratch& scratch )
 {
-  public:
-    Line( int i1 = 0, int i2 = 0 )
-        : from( i1 )
-        , to( i2 )
+    if ( scratch.indices.size() < nPoints )
+        scratch.indices.resize( nPoints );
+
+    int* indices = scratch.indices.data();
+
+    if ( nPoints <= 2 )
     {
+        for ( int i = 0; i < nPoints; i++ )
+            indices[i] = i;
+
+        return nPoints;
     }
 
-    int from;
-    int to;
-};
+    if ( scratch.stack.size() < 64 )
+        scratch.stack.resize( 64 );
+
+    Line* stack = scratch.stack.data();
+    int stackSize = 0;
+
+    stack[stackSize++] = Line( 0, nPoints - 1 );
+
+    int numIndices = 0;
+
+    while ( stackSize > 0 )
+    {
+        const Line r = stack[--stackSize];
+
+        // initialize line segment
+        const double vecX = p[r.to].x() - p[r.from].x();
+        const double vecY = p[r.to].y() - p[r.from].y();
+
+        const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
+
+        const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
+        const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
+
+        double maxDistSqr = 0.0;
+        int nVertexIndexMaxDistance = r.from + 1;
+        for ( int i = r.from + 1; i < r.to; i++ )
+        {
+            //compare to anchor
+            const double fromVecX = p[i].x() - p[r.from].x();
+            const double fromVecY = p[i].y() - p[r.from].y();
+
+            double distToSegmentSqr;
+            if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
+            {
+                distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
+            }
+            else
+            {
+                const double toVecX = p[i].x() - p[r.to].x();
+                const double toVecY = p[i].y() - p[r.to].y();
+                const double toVecLength = toVecX * toVecX + toVecY * toVecY;
+
+                const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
+                if ( s < 0.0 )
+                {
+                    distToSegmentSqr = toVecLength;
+                }
+                else
+                {
+                    distToSegmentSqr = std::fabs( toVecLength - s * s );
+                }
+            }
+
+            if ( maxDistSqr < distToSegmentSqr )
+            {
+                maxDistSqr = distToSegmentSqr;
+                nVertexIndexMaxDistance = i;
+            }
+        }
+
+        if ( maxDistSqr <= toleranceSqr )
+        {
+            // the end point is the start of the following line
+            indices[numIndices++] = r.from;
+        }
+        else
+        {
+            if ( stackSize + 2 > scratch.stack.size() )
+            {
+                scratch.stack.resize( 2 * scratch.stack.size() );
+                stack = scratch.stack.data();
+            }
+
+            stack[stackSize++] = Line( nVertexIndexMaxDistance, r.to );
+            stack[stackSize++] = Line( r.from, nVertexIndexMaxDistance );
+        }
+    }
+
+    indices[numIndices++] = nPoints - 1;
+
+    return numIndices;
+}
+
+QPolygonF QwtWeedingCurveFitter::PrivateData::simplifyChunks( const ChunkJob& job )
+{
+    QPolygonF stripped;
+
+    for ( int i = job.from; i < job.to; i += job.chunkSize )
+    {
+        const QPointF* p = job.points + i;
+
+        const int numIndices = simplify( p,
+            qMin( job.chunkSize, job.to - i ), job.toleranceSqr, *job.scratch );
+
+        const int* indices = job.scratch->indices.constData();
+        for ( int j = 0; j < numIndices; j++ )
+            stripped += p[ indices[j] ];
+    }
+
+    return stripped;
+}
+
+QPolygonF QwtWeedingCurveFitter::PrivateData::fitChunks( const QPolygonF& points )
+{
+    const int numPoints = points.size();
+    const int numChunks = ( numPoints + int( chunkSize ) - 1 ) / int( chunkSize );
+
+    ChunkJob job;
+    job.points = points.constData();
+    job.from = 0;
+    job.to = numPoints;
+    job.chunkSize = chunkSize;
+    job.toleranceSqr = tolerance * tolerance;
+    job.scratch = &scratch;
+
+#if QWT_USE_THREADS
+    int numJobs = ( numThreads == 0 ) ? QThread::idealThreadCount() : int( numThreads );
+    numJobs = qMin( numJobs, numChunks );
+    numJobs = qMin( numJobs, numPoints / qwtMinPointsPerThread );
+
+    if ( numJobs > 1 )
+    {
+        // each job runs a contiguous range of chunks with its own buffers
+        const int chunksPerJob = ( numChunks + numJobs - 1 ) / numJobs;
+        numJobs = ( numChunks + chunksPerJob - 1 ) / chunksPerJob;
+
+        if ( threadScratch.size() < numJobs )
+            threadScratch.resize( numJobs );
+
+        Scratch* scratches = threadScratch.data();
+
+        QList< QFuture< QPolygonF > > futures;
+        for ( int i = 0; i < numJobs - 1; i++ )
+        {
+            job.from = i * chunksPerJob * job.chunkSize;
+            job.to = job.from + chunksPerJob * job.chunkSize;
+            job.scratch = &scratches[i];
+
+            futures += QtConcurrent::run( &PrivateData::simplifyChunks, job );
+        }
+
+        // the last job in the current thread
+        job.from = ( numJobs - 1 ) * chunksPerJob * job.chunkSize;
+        job.to = numPoints;
+        job.scratch = &scratches[numJobs - 1];
+
+        const QPolygonF lastPoints = simplifyChunks( job );
+
+        QVector< QPolygonF > results;
+        results.reserve( numJobs );
+
+        int numStripped = lastPoints.size();
+        for ( int i = 0; i < futures.size(); i++ )
+        {
+            results += futures[i].result();
+            numStripped += results.last().size();
+        }
+
+        QPolygonF stripped;
+        stripped.reserve( numStripped );
+
+        for ( int i = 0; i < results.size(); i++ )
+            stripped += results[i];
+
+        stripped += lastPoints;
+
+        return stripped;
+    }
+#endif
+
+    return simplifyChunks( job );
+}
+
+/*
+   The points up to streamAnchor have been simplified in a previous run.
+   As long as they are unmodified only the tail starting at the anchor
+   needs to be simplified again. All points of the tail result, but the
+   last segment, are frozen - the last segment might change, when
+   more points are appended.
+ */
+QPolygonF QwtWeedingCurveFitter::PrivateData::fitStream( const QPolygonF& points )
+{
+    const int numPoints = points.size();
+
+    bool isAppended = ( streamAnchor < numPoints )
+        && ( streamAnchor < streamInput.size() );
+
+    if ( isAppended && points.constData() != streamInput.constData() )
+    {
+        isAppended = std::memcmp( points.constData(), streamInput.constData(),
+            ( streamAnchor + 1 ) * sizeof( QPointF ) ) == 0;
+    }
+
+    if ( !isAppended )
+    {
+        streamFitted.clear();
+        streamAnchor = 0;
+    }
+
+    const QPointF* p = points.constData() + streamAnchor;
+    const int numTail = numPoints - streamAnchor;
+
+    const int numIndices = simplify( p, numTail, tolerance * tolerance, scratch );
+    const int* indices = scratch.indices.constData();
+
+    int numFrozen = 0;
+    if ( numIndices >= 3 )
+    {
+        numFrozen = numIndices - 2;
+    }
+    else if ( numIndices == 2 && chunkSize > 0 && numTail >= int( chunkSize ) )
+    {
+        // limiting the number of points, that have to be checked again
+        numFrozen = 1;
+    }
+
+    for ( int i = 0; i < numFrozen; i++ )
+        streamFitted += p[ indices[i] ];
+
+    QPolygonF stripped;
+    stripped.reserve( streamFitted.size() + numIndices - numFrozen );
+
+    stripped += streamFitted;
+    for ( int i = numFrozen; i < numIndices; i++ )
+        stripped += p[ indices[i] ];
+
+    streamAnchor += indices[numFrozen];
+    streamInput = points;
+
+    return stripped;
+}
 
 /*!
    Constructor
@@ -76,6 +389,7 @@ QwtWeedingCurveFitter::~QwtWeedingCurveFitter()
 void QwtWeedingCurveFitter::setTolerance( double tolerance )
 {
     m_data->tolerance = qwtMaxF( tolerance, 0.0 );
+    resetStream();
 }
 
 /*!
@@ -104,6 +418,7 @@ void QwtWeedingCurveFitter::setChunkSize( uint numPoints )
         numPoints = qMax( numPoints, 3U );
 
     m_data->chunkSize = numPoints;
+    resetStream();
 }
 
 /*!
@@ -116,31 +431,116 @@ uint QwtWeedingCurveFitter::chunkSize() const
     return m_data->chunkSize;
 }
 
+/*!
+   Set the number of threads for simplifying the chunks of a polygon
+
+   Chunks are processed in parallel only, when a chunk size has been
+   set and the polygon has enough points to be worth the overhead.
+
+   \param numThreads Number of threads, where 0 means the system
+                     specific ideal thread count
+
+   \sa threadCount(), setChunkSize()
+ */
+void QwtWeedingCurveFitter::setThreadCount( uint numThreads )
+{
+    m_data->numThreads = numThreads;
+}
+
+/*!
+   \return Number of threads for simplifying chunks, where 0 means
+           the system specific ideal thread count
+   \sa setThreadCount()
+ */
+uint QwtWeedingCurveFitter::threadCount() const
+{
+    return m_data->numThreads;
+}
+
+/*!
+   \brief En/Disable the streaming mode
+
+   In streaming mode the fitter remembers the polygon of the previous
+   call of fitCurve(). When the next polygon starts with the same points
+   - what is the case, when samples have been appended - only the
+   tail after the last stable point of the previous result is simplified
+   again, while the points before are taken from the previous result.
+
+   The result is not necessarily identical to simplifying the complete
+   polygon at once, but it also respects the tolerance. Any other
+   modification of the polygon results in simplifying it from
+   scratch - see fitCurve() for when this happens with QwtPlotCurve. When a chunk size has been set, it limits the number of
+   points of the tail. Chunks are not processed in parallel in
+   streaming mode.
+
+   \param on On/Off
+   \sa isStreaming(), resetStream()
+ */
+void QwtWeedingCurveFitter::setStreaming( bool on )
+{
+    if ( on != m_data->streaming )
+    {
+        m_data->streaming = on;
+        resetStream();
+    }
+}
+
+/*!
+   \return True, when the streaming mode is enabled
+   \sa setStreaming()
+ */
+bool QwtWeedingCurveFitter::isStreaming() const
+{
+    return m_data->streaming;
+}
+
+/*!
+   Discard the state of the streaming mode, so that the next
+   polygon will be simplified completely.
+
+   \sa setStreaming()
+ */
+void QwtWeedingCurveFitter::resetStream()
+{
+    m_data->streamInput = QPolygonF();
+    m_data->streamFitted = QPolygonF();
+    m_data->streamAnchor = 0;
+}
+
 /*!
    \param points Series of data points
    \return Curve points
-   \sa fitCurvePath()
+
+   In streaming mode the previous result is reused only, when the points
+   of the previous call are an unmodified prefix of points - compared
+   bitwise. For a QwtPlotCurve with the Fitted attribute, the points are
+   in paint device coordinates and clipped with ClipPolygons. So the
+   incremental path applies only as long as the scale maps are unchanged
+   and the curve is not clipped at its beginning. Any scrolling,
+   autoscaling, resizing or a change of the axes restarts the stream.
+
+   For a live plot with scrolling axes the fitter can be applied to the
+   samples in scale coordinates instead, before passing them to the curve.
+   Then the tolerance is in scale coordinates too.
+
+   \note Even if being const fitCurve() modifies the internal buffers
+         and the state of the streaming mode. It must not be called
+         concurrently and a fitter must not be shared between curves.
+
+   \sa fitCurvePath(), setStreaming()
  */
 QPolygonF QwtWeedingCurveFitter::fitCurve( const QPolygonF& points ) const
 {
     if ( points.isEmpty() )
         return points;
 
-    QPolygonF fittedPoints;
+    if ( m_data->streaming )
+        return m_data->fitStream( points );
+
     if ( m_data->chunkSize == 0 )
-    {
-        fittedPoints = simplify( points );
-    }
-    else
-    {
-        for ( int i = 0; i < points.size(); i += m_data->chunkSize )
-        {
-            const QPolygonF p = points.mid( i, m_data->chunkSize );
-            fittedPoints += simplify( p );
-        }
-    }
+        return simplify( points );
 
-    return fittedPoints;
+    return m_data->fitChunks( points );
 }
 
 /*!
@@ -157,85 +557,18 @@ QPainterPath QwtWeedingCurveFitter::fitCurvePath( const QPolygonF& points ) cons
 
 QPolygonF QwtWeedingCurveFitter::simplify( const QPolygonF& points ) const
 {
-    const double toleranceSqr = m_data->tolerance * m_data->tolerance;
-
-    QStack< Line > stack;
-    stack.reserve( 500 );
+    const QPointF* p = points.constData();
 
-    const QPointF* p = points.data();
-    const int nPoints = points.size();
+    const int numIndices = PrivateData::simplify( p, points.size(),
+        m_data->tolerance * m_data->tolerance, m_data->scratch );
 
-    QVector< bool > usePoint( nPoints, false );
+    const int* indices = m_data->scratch.indices.constData();
 
-    stack.push( Line( 0, nPoints - 1 ) );
-
-    while ( !stack.isEmpty() )
-    {
-        const Line r = stack.pop();
+    QPolygonF stripped( numIndices );
 
-        // initialize line segment
-        const double vecX = p[r.to].x() - p[r.from].x();
-        const double vecY = p[r.to].y() - p[r.from].y();
-
-        const double vecLength = std::sqrt( vecX * vecX + vecY * vecY );
-
-        const double unitVecX = ( vecLength != 0.0 ) ? vecX / vecLength : 0.0;
-        const double unitVecY = ( vecLength != 0.0 ) ? vecY / vecLength : 0.0;
-
-        double maxDistSqr = 0.0;
-        int nVertexIndexMaxDistance = r.from + 1;
-        for ( int i = r.from + 1; i < r.to; i++ )
-        {
-            //compare to anchor
-            const double fromVecX = p[i].x() - p[r.from].x();
-            const double fromVecY = p[i].y() - p[r.from].y();
-
-            double distToSegmentSqr;
-            if ( fromVecX * unitVecX + fromVecY * unitVecY < 0.0 )
-            {
-                distToSegmentSqr = fromVecX * fromVecX + fromVecY * fromVecY;
-            }
-            else
-            {
-                const double toVecX = p[i].x() - p[r.to].x();
-                const double toVecY = p[i].y() - p[r.to].y();
-                const double toVecLength = toVecX * toVecX + toVecY * toVecY;
-
-                const double s = toVecX * ( -unitVecX ) + toVecY * ( -unitVecY );
-                if ( s < 0.0 )
-                {
-                    distToSegmentSqr = toVecLength;
-                }
-                else
-                {
-                    distToSegmentSqr = std::fabs( toVecLength - s * s );
-                }
-            }
-
-            if ( maxDistSqr < distToSegmentSqr )
-            {
-                maxDistSqr = distToSegmentSqr;
-                nVertexIndexMaxDistance = i;
-            }
-        }
-        if ( maxDistSqr <= toleranceSqr )
-        {
-            usePoint[r.from] = true;
-            usePoint[r.to] = true;
-        }
-        else
-        {
-            stack.push( Line( r.from, nVertexIndexMaxDistance ) );
-            stack.push( Line( nVertexIndexMaxDistance, r.to ) );
-        }
-    }
-
-    QPolygonF stripped;
-    for ( int i = 0; i < nPoints; i++ )
-    {
-        if ( usePoint[i] )
-            stripped += p[i];
-    }
+    QPointF* strippedPoints = stripped.data();
+    for ( int i = 0; i < numIndices; i++ )
+        strippedPoints[i] = p[ indices[i] ];
 
     return stripped;
 }
@@ -34,6 +34,16 @@
    the number of points. By adjusting the tolerance parameter according to the
    axis scales QwtSplineCurveFitter can be used to implement different
    level of details to speed up painting of curves of many points.
+
+   When splitting the polygon into chunks the chunks can be processed
+   in parallel ( setThreadCount() ). For live curves, where samples are
+   appended between replots, the streaming mode ( setStreaming() ) avoids
+   refitting the complete polygon each time, as long as the previous
+   polygon is an unmodified prefix ( see fitCurve() ).
+
+   \note fitCurve() reuses internal buffers and updates the state of the
+         streaming mode. So it is not reentrant and a fitter must not
+         be shared between curves or threads.
  */
 class QWT_EXPORT QwtWeedingCurveFitter : public QwtCurveFitter
 {
@@ -47,6 +57,14 @@ class QWT_EXPORT QwtWeedingCurveFitter : public QwtCurveFitter
     void setChunkSize( uint );
     uint chunkSize() const;
 
+    void setThreadCount( uint numThreads );
+    uint threadCount() const;
+
+    void setStreaming( bool );
+    bool isStreaming() const;
+
+    void resetStream();
+
     virtual QPolygonF fitCurve( const QPolygonF& ) const QWT_OVERRIDE;
     virtual QPainterPath fitCurvePath( const QPolygonF& ) const QWT_OVERRIDE;
 
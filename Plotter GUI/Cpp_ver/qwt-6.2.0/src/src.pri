@@ -23,6 +23,7 @@ HEADERS += \
     qwt_graphic.h \
     qwt_interval.h \
     qwt_interval_symbol.h \
+    qwt_line_rasterizer.h \
     qwt_math.h \
     qwt_magnifier.h \
     qwt_null_paintdevice.h \
@@ -69,6 +70,7 @@ SOURCES += \
     qwt_graphic.cpp \
     qwt_interval.cpp \
     qwt_interval_symbol.cpp \
+    qwt_line_rasterizer.cpp \
     qwt_math.cpp \
     qwt_magnifier.cpp \
     qwt_null_paintdevice.cpp \
@@ -226,15 +228,25 @@ contains(QWT_CONFIG, QwtPlot) {
 
                 greaterThan(QT_MINOR_VERSION, 3) {
 
-                    HEADERS += qwt_plot_opengl_canvas.h
-                    SOURCES += qwt_plot_opengl_canvas.cpp
+                    HEADERS += \
+                        qwt_plot_opengl_canvas.h \
+                        qwt_plot_opengl_curve.h
+
+                    SOURCES += \
+                        qwt_plot_opengl_canvas.cpp \
+                        qwt_plot_opengl_curve.cpp
                 }
             }
             else {
                 QT += openglwidgets
 
-                HEADERS += qwt_plot_opengl_canvas.h
-                SOURCES += qwt_plot_opengl_canvas.cpp
+                HEADERS += \
+                    qwt_plot_opengl_canvas.h \
+                    qwt_plot_opengl_curve.h
+
+                SOURCES += \
+                    qwt_plot_opengl_canvas.cpp \
+                    qwt_plot_opengl_curve.cpp
             }
             
         }
@@ -0,0 +1,172 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtClipper>
+#include <QwtPlotCurve>
+#include <QwtScaleMap>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QImage>
+#include <QPolygonF>
+#include <QVector>
+#include <QDebug>
+
+#include <cmath>
+
+static const int numRuns = 10;
+
+static void report( const char* name, const QElapsedTimer& timer, int numPoints )
+{
+    qDebug() << name << ":" << timer.elapsed() << "ms"
+             << double( timer.nsecsElapsed() ) / ( numRuns * numPoints ) << "ns/point";
+}
+
+/*
+   A signal, that stays inside of the rectangle most of the time,
+   with excursions far outside of it for excursionRatio of the points
+ */
+static QPolygonF createPolyline( const QRectF& rect,
+    int numPoints, double excursionRatio )
+{
+    QPolygonF polyline( numPoints );
+
+    const int period = 10000;
+    const int excursionLength = qRound( period * excursionRatio );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const double x = rect.left() + rect.width() * i / numPoints;
+
+        double y = rect.center().y()
+            + 0.4 * rect.height() * std::sin( 0.01 * i );
+
+        if ( i % period < excursionLength )
+            y += 10 * rect.height();
+
+        polyline[i] = QPointF( x, y );
+    }
+
+    return polyline;
+}
+
+static void testClipping( const char* name,
+    const QRectF& clipRect, const QPolygonF& polyline )
+{
+    qDebug() << "===" << name << polyline.size() << "points";
+
+    int numClipped = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+    {
+        const QPolygonF clipped =
+            QwtClipper::clippedPolygonF( clipRect, polyline );
+
+        numClipped = clipped.size();
+    }
+
+    report( "clippedPolygonF", timer, polyline.size() );
+
+    QPolygonF buffer;
+
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+        QwtClipper::clipPolygonF( clipRect, polyline, buffer );
+
+    report( "clipPolygonF, buffer", timer, polyline.size() );
+
+    int numParts = 0;
+    int numSplit = 0;
+
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+    {
+        const QVector< QPolygonF > parts =
+            QwtClipper::splitPolylineF( clipRect, polyline );
+
+        numParts = parts.size();
+
+        numSplit = 0;
+        for ( int j = 0; j < parts.size(); j++ )
+            numSplit += parts[j].size();
+    }
+
+    report( "splitPolylineF", timer, polyline.size() );
+
+    qDebug() << "clipped:" << numClipped << "points,"
+             << "split:" << numParts << "parts" << numSplit << "points";
+
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+    {
+        const QPolygonF clipped =
+            QwtClipper::clippedPolygonF( clipRect, polyline, true );
+    }
+
+    report( "clippedPolygonF, closed", timer, polyline.size() );
+}
+
+static void testCurve( const char* name, const QRectF& canvasRect,
+    const QPolygonF& polyline, const QPen& pen )
+{
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( canvasRect.left(), canvasRect.right() );
+    xMap.setPaintInterval( canvasRect.left(), canvasRect.right() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( canvasRect.top(), canvasRect.bottom() );
+    yMap.setPaintInterval( canvasRect.top(), canvasRect.bottom() );
+
+    QwtPlotCurve curve;
+    curve.setStyle( QwtPlotCurve::Lines );
+    curve.setPaintAttribute( QwtPlotCurve::ClipPolygons, true );
+    curve.setPen( pen );
+    curve.setSamples( polyline );
+
+    QImage image( canvasRect.size().toSize(), QImage::Format_ARGB32_Premultiplied );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+    {
+        image.fill( Qt::white );
+
+        QPainter painter( &image );
+        curve.draw( &painter, xMap, yMap, canvasRect );
+    }
+
+    report( name, timer, polyline.size() );
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const QRectF rect( 0.0, 0.0, 1920.0, 1080.0 );
+    const int numPoints = 1000000;
+
+    const QPolygonF inside = createPolyline( rect, numPoints, 0.0 );
+    testClipping( "inside", rect, inside );
+
+    const QPolygonF excursions = createPolyline( rect, numPoints, 0.5 );
+    testClipping( "long excursions", rect, excursions );
+
+    qDebug() << "=== QwtPlotCurve::Lines" << numPoints << "points";
+
+    testCurve( "Lines, inside", rect, inside, QPen( Qt::darkBlue ) );
+    testCurve( "Lines, long excursions", rect, excursions, QPen( Qt::darkBlue ) );
+    testCurve( "Lines, long excursions, dashed", rect, excursions,
+        QPen( Qt::darkBlue, 1.0, Qt::DashLine ) );
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtPlotCurve>
+#include <QwtScaleMap>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QImage>
+#include <QPolygonF>
+#include <QDebug>
+
+#include <cmath>
+
+static const int numRuns = 5;
+
+/*
+   A noisy signal with increasing x coordinates, where many
+   thousand samples are mapped to the same pixel column
+ */
+static QPolygonF createSeries( int numPoints )
+{
+    QPolygonF points( numPoints );
+
+    quint32 random = 1;
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        random = random * 1664525u + 1013904223u;
+        const double noise = double( random >> 8 ) / double( 1 << 24 ) - 0.5;
+
+        const double x = double( i ) / numPoints;
+        const double y = std::sin( 20.0 * x ) + 0.3 * noise;
+
+        points[i] = QPointF( x, y );
+    }
+
+    return points;
+}
+
+static QImage render( const char* name, const QSize& size,
+    const QPolygonF& samples, bool minMaxColumns )
+{
+    const QRectF canvasRect( QPointF( 0.0, 0.0 ), size );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, 1.0 );
+    xMap.setPaintInterval( canvasRect.left(), canvasRect.right() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( -1.5, 1.5 );
+    yMap.setPaintInterval( canvasRect.bottom(), canvasRect.top() );
+
+    QwtPlotCurve curve;
+    curve.setStyle( QwtPlotCurve::Lines );
+    curve.setPaintAttribute( QwtPlotCurve::FilterPoints, false );
+    curve.setPaintAttribute( QwtPlotCurve::MinMaxColumns, minMaxColumns );
+    curve.setRenderHint( QwtPlotItem::RenderAntialiased, false );
+    curve.setPen( QPen( Qt::darkBlue, 1.0 ) );
+    curve.setSamples( samples );
+
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for ( int i = 0; i < numRuns; i++ )
+    {
+        image.fill( Qt::white );
+
+        QPainter painter( &image );
+        curve.draw( &painter, xMap, yMap, canvasRect );
+    }
+
+    qDebug() << name << ":" << timer.elapsed() / numRuns << "ms";
+
+    return image;
+}
+
+static int compare( const QImage& image1, const QImage& image2 )
+{
+    int numErrors = 0;
+
+    for ( int y = 0; y < image1.height(); y++ )
+    {
+        const QRgb* line1 = reinterpret_cast< const QRgb* >( image1.constScanLine( y ) );
+        const QRgb* line2 = reinterpret_cast< const QRgb* >( image2.constScanLine( y ) );
+
+        for ( int x = 0; x < image1.width(); x++ )
+        {
+            if ( line1[x] != line2[x] )
+            {
+                if ( numErrors < 10 )
+                    qDebug() << "  different pixel at" << x << y;
+
+                numErrors++;
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const QSize sizes[] = { QSize( 800, 600 ), QSize( 1920, 1080 ), QSize( 97, 50 ) };
+    const int numPoints = 1000000;
+
+    const QPolygonF samples = createSeries( numPoints );
+
+    int numErrors = 0;
+
+    for ( size_t i = 0; i < sizeof( sizes ) / sizeof( sizes[0] ); i++ )
+    {
+        const QSize& size = sizes[i];
+
+        qDebug() << "===" << numPoints << "points" << size;
+
+        const QImage full = render( "all points", size, samples, false );
+        const QImage reduced = render( "MinMaxColumns", size, samples, true );
+
+        const int errors = compare( full, reduced );
+        if ( errors > 0 )
+            qDebug() << "  " << errors << "different pixels";
+
+        numErrors += errors;
+    }
+
+    return ( numErrors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,248 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtPlotCurve>
+#include <QwtPlotOpenGLCurve>
+#include <QwtPointSeriesData>
+#include <QwtScaleMap>
+
+#include <QGuiApplication>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLPaintDevice>
+#include <QPainter>
+#include <QImage>
+#include <QPolygonF>
+#include <QDebug>
+
+static const QSize imageSize( 800, 600 );
+
+/*
+   A sparse series with steep segments, so that a misplaced
+   vertex can't be hidden by its neighbours
+ */
+static QPolygonF createSeries( int from, int to, double offset = 0.0 )
+{
+    QPolygonF points;
+
+    for ( int i = from; i < to; i++ )
+        points += QPointF( offset + 10.0 * i, ( ( i * 37 ) % 17 ) / 8.0 - 1.0 );
+
+    return points;
+}
+
+static void initMaps( const QPolygonF& samples, int from,
+    QwtScaleMap& xMap, QwtScaleMap& yMap )
+{
+    xMap.setScaleInterval( samples[from].x(), samples.last().x() );
+    xMap.setPaintInterval( 0.0, imageSize.width() - 1 );
+
+    yMap.setScaleInterval( -1.5, 1.5 );
+    yMap.setPaintInterval( imageSize.height() - 1, 0.0 );
+}
+
+static void initCurve( QwtPlotCurve* curve )
+{
+    curve->setStyle( QwtPlotCurve::Lines );
+    curve->setPaintAttribute( QwtPlotCurve::FilterPoints, false );
+    curve->setRenderHint( QwtPlotItem::RenderAntialiased, false );
+    curve->setPen( QPen( Qt::darkBlue, 1.0 ) );
+}
+
+static QImage render( const QwtPlotCurve* curve,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, int from, int to )
+{
+    QOpenGLFramebufferObject fbo( imageSize );
+    fbo.bind();
+
+    QOpenGLPaintDevice device( imageSize );
+
+    {
+        QPainter painter( &device );
+        painter.fillRect( QRect( QPoint(), imageSize ), Qt::white );
+
+        curve->drawSeries( &painter, xMap, yMap,
+            QRectF( QPointF(), imageSize ), from, to );
+    }
+
+    fbo.release();
+
+    return fbo.toImage().convertToFormat( QImage::Format_RGB32 );
+}
+
+/*
+   The line rasterization of the OpenGL implementation might
+   differ slightly from the one of the paint engine. So a pixel
+   of the curve is accepted, when it can be found in its neighbourhood.
+ */
+static int countMissing( const QImage& image1, const QImage& image2 )
+{
+    int numErrors = 0;
+
+    for ( int y = 0; y < image1.height(); y++ )
+    {
+        for ( int x = 0; x < image1.width(); x++ )
+        {
+            const QRgb rgb = image1.pixel( x, y );
+            if ( rgb == qRgb( 255, 255, 255 ) )
+                continue;
+
+            bool found = false;
+
+            for ( int dy = -1; dy <= 1 && !found; dy++ )
+            {
+                for ( int dx = -1; dx <= 1 && !found; dx++ )
+                {
+                    const QPoint pos( x + dx, y + dy );
+                    if ( image2.rect().contains( pos ) )
+                        found = image2.pixel( pos ) != qRgb( 255, 255, 255 );
+                }
+            }
+
+            if ( !found )
+            {
+                if ( numErrors < 10 )
+                    qDebug() << "    missing pixel at" << x << y;
+
+                numErrors++;
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+/*
+   Both curves are set to the same samples. The OpenGL curve is expected
+   to draw the samples, that are available in its buffer, like QwtPlotCurve
+ */
+static int compare( QwtPlotCurve* curve,
+    QwtPlotOpenGLCurve* glCurve, const QPolygonF& samples )
+{
+    curve->setSamples( samples );
+
+    // keeping the address of the series, so that appended samples are detected
+    static_cast< QwtPointSeriesData* >( glCurve->data() )->setSamples( samples );
+
+    const int numSamples = static_cast< int >( samples.size() );
+    const int capacity = glCurve->bufferCapacity();
+
+    const int from = ( capacity > 0 ) ? qMax( numSamples - capacity, 0 ) : 0;
+    const int to = numSamples - 1;
+
+    QwtScaleMap xMap, yMap;
+    initMaps( samples, from, xMap, yMap );
+
+    const QImage image1 = render( curve, xMap, yMap, from, to );
+    const QImage image2 = render( glCurve, xMap, yMap, 0, to );
+
+    const int errors = countMissing( image1, image2 ) + countMissing( image2, image1 );
+    if ( errors > 0 )
+    {
+        qDebug() << "  " << errors << "different pixels for the samples"
+                 << from << "-" << to;
+    }
+
+    return errors;
+}
+
+/*
+   Appending a few samples for each replot, so that the
+   ring buffer wraps around at different positions
+ */
+static int append( QwtPlotCurve* curve, QwtPlotOpenGLCurve* glCurve,
+    QPolygonF& samples, int to, double offset = 0.0 )
+{
+    const int step = 7;
+
+    while ( samples.size() < to )
+    {
+        const int numSamples = static_cast< int >( samples.size() );
+
+        samples += createSeries( numSamples,
+            qMin( numSamples + step, to ), offset );
+
+        const int errors = compare( curve, glCurve, samples );
+        if ( errors > 0 )
+            return errors;
+    }
+
+    return 0;
+}
+
+int main( int argc, char* argv[] )
+{
+    // allows running the test on systems without a GPU
+    if ( qEnvironmentVariableIsEmpty( "LIBGL_ALWAYS_SOFTWARE" ) )
+        qputenv( "LIBGL_ALWAYS_SOFTWARE", "1" );
+
+    QGuiApplication app( argc, argv );
+
+    QOpenGLContext context;
+    if ( !context.create() )
+    {
+        qWarning() << "Can't create an OpenGL context";
+        return 1;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat( context.format() );
+    surface.create();
+
+    if ( !context.makeCurrent( &surface ) )
+    {
+        qWarning() << "Can't make the OpenGL context current";
+        return 1;
+    }
+
+    int numErrors = 0;
+
+    QPolygonF samples = createSeries( 0, 200 );
+
+    QwtPlotCurve curve;
+    initCurve( &curve );
+
+    QwtPlotOpenGLCurve glCurve;
+    initCurve( &glCurve );
+    glCurve.setAppendOnly( true );
+    glCurve.setSamples( samples );
+
+    qDebug() << "===" << samples.size() << "points";
+    numErrors += compare( &curve, &glCurve, samples );
+
+    qDebug() << "=== appended";
+    numErrors += append( &curve, &glCurve, samples, 300 );
+
+    const int capacity = 100;
+    glCurve.setBufferCapacity( capacity );
+
+    qDebug() << "=== capacity:" << capacity;
+    numErrors += compare( &curve, &glCurve, samples );
+
+    qDebug() << "=== wrapping around";
+    numErrors += append( &curve, &glCurve, samples, 600 );
+
+    /*
+        After a gap the values are far away from the first samples
+        like for a time axis of a long running series. Without rebasing
+        the origin the float precision of the buffer would be exceeded.
+     */
+
+    qDebug() << "=== long running";
+    numErrors += append( &curve, &glCurve, samples, 750, 1e8 );
+
+    // modified in place with the same size and the same last sample
+
+    qDebug() << "=== modified";
+
+    for ( int i = 0; i < samples.size() - 1; i++ )
+        samples[i].ry() = -samples[i].y();
+
+    glCurve.invalidateBuffer();
+    numErrors += compare( &curve, &glCurve, samples );
+
+    return ( numErrors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtLineRasterizer>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QImage>
+#include <QPolygonF>
+#include <QDebug>
+
+static const QSize imageSize( 640, 480 );
+
+/*
+   Random points, where most segments are steep and some
+   of them are leaving the image
+ */
+static QPolygonF createSeries( int numPoints, int margin )
+{
+    QPolygonF points( numPoints );
+
+    quint32 random = 1;
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        random = random * 1664525u + 1013904223u;
+        const double y = double( random >> 8 ) / double( 1 << 24 );
+
+        random = random * 1664525u + 1013904223u;
+        const double dx = double( random >> 8 ) / double( 1 << 24 );
+
+        const double x = ( i + dx ) * ( imageSize.width() + 2 * margin ) / numPoints;
+
+        points[i] = QPointF( x - margin,
+            -margin + y * ( imageSize.height() + 2 * margin ) );
+    }
+
+    return points;
+}
+
+static QImage rasterize( const char* name, const QPolygonF& points,
+    bool antialiased, uint numThreads )
+{
+    QImage image( imageSize, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QwtLineRasterizer rasterizer;
+    rasterizer.setColor( QColor( 0, 0, 0, 200 ) );
+    rasterizer.setAntialiasing( antialiased );
+    rasterizer.setThreadCount( numThreads );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    rasterizer.drawPolyline( image, points.constData(), points.size() );
+
+    qDebug() << "  " << name << ":" << timer.elapsed() << "ms";
+
+    return image;
+}
+
+static QImage paint( const QPolygonF& points, bool antialiased )
+{
+    QImage image( imageSize, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QPen pen( QColor( 0, 0, 0, 200 ) );
+    pen.setWidth( 0 );
+    pen.setCosmetic( true );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    {
+        QPainter painter( &image );
+        painter.setRenderHint( QPainter::Antialiasing, antialiased );
+        painter.setPen( pen );
+        painter.drawPolyline( points );
+    }
+
+    qDebug() << "  " << "QPainter" << ":" << timer.elapsed() << "ms";
+
+    return image;
+}
+
+static int compareExact( const QImage& image1, const QImage& image2 )
+{
+    int numErrors = 0;
+
+    for ( int y = 0; y < image1.height(); y++ )
+    {
+        const QRgb* line1 = reinterpret_cast< const QRgb* >( image1.constScanLine( y ) );
+        const QRgb* line2 = reinterpret_cast< const QRgb* >( image2.constScanLine( y ) );
+
+        for ( int x = 0; x < image1.width(); x++ )
+        {
+            if ( line1[x] != line2[x] )
+            {
+                if ( numErrors < 10 )
+                    qDebug() << "    different pixel at" << x << y;
+
+                numErrors++;
+            }
+        }
+    }
+
+    if ( numErrors > 0 )
+        qDebug() << "  " << numErrors << "different pixels";
+
+    return numErrors;
+}
+
+static inline int coverage( const QImage& image, int x, int y )
+{
+    return 255 - qRed( image.pixel( x, y ) );
+}
+
+/*
+   Lines are not rasterized pixel identical to QPainter. So a pixel,
+   that is covered by one image, has to be found in the neighbourhood
+   of the other image.
+ */
+static int countMissing( const QImage& image1, const QImage& image2 )
+{
+    // pixels with a lower coverage are antialiasing fringes
+    const int minCoverage = 100;
+
+    int numErrors = 0;
+
+    for ( int y = 0; y < image1.height(); y++ )
+    {
+        for ( int x = 0; x < image1.width(); x++ )
+        {
+            if ( coverage( image1, x, y ) < minCoverage )
+                continue;
+
+            bool found = false;
+
+            for ( int dy = -1; dy <= 1 && !found; dy++ )
+            {
+                for ( int dx = -1; dx <= 1 && !found; dx++ )
+                {
+                    const QPoint pos( x + dx, y + dy );
+                    if ( image2.rect().contains( pos ) )
+                        found = coverage( image2, pos.x(), pos.y() ) > 0;
+                }
+            }
+
+            if ( !found )
+            {
+                if ( numErrors < 10 )
+                    qDebug() << "    missing pixel at" << x << y;
+
+                numErrors++;
+            }
+        }
+    }
+
+    return numErrors;
+}
+
+static int compareNeighbourhood( const QImage& image1, const QImage& image2 )
+{
+    const int numErrors = countMissing( image1, image2 ) + countMissing( image2, image1 );
+    if ( numErrors > 0 )
+        qDebug() << "  " << numErrors << "pixels without a neighbour";
+
+    return numErrors;
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    int numErrors = 0;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        const bool antialiased = ( i == 1 );
+
+        {
+            const QPolygonF points = createSeries( 300, 50 );
+
+            qDebug() << "===" << points.size() << "points, antialiased:" << antialiased;
+
+            numErrors += compareNeighbourhood(
+                paint( points, antialiased ),
+                rasterize( "QwtLineRasterizer", points, antialiased, 1 ) );
+        }
+
+        {
+            // enough points for being split into bands
+
+            const QPolygonF points = createSeries( 200000, 50 );
+
+            qDebug() << "===" << points.size() << "points, antialiased:" << antialiased;
+
+            numErrors += compareExact(
+                rasterize( "1 band", points, antialiased, 1 ),
+                rasterize( "8 bands", points, antialiased, 8 ) );
+
+            numErrors += compareExact(
+                rasterize( "1 band", points, antialiased, 1 ),
+                rasterize( "7 bands", points, antialiased, 7 ) );
+        }
+    }
+
+    return ( numErrors == 0 ) ? 0 : 1;
+}
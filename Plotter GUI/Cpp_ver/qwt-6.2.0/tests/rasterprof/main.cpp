@@ -0,0 +1,168 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtPlotSpectrogram>
+#include <QwtMatrixRasterData>
+#include <QwtLinearColorMap>
+#include <QwtScaleMap>
+#include <QwtInterval>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QVector>
+#include <QDebug>
+
+#include <cmath>
+
+namespace
+{
+    class Spectrogram : public QwtPlotSpectrogram
+    {
+      public:
+        QImage render( const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+            const QSize& size ) const
+        {
+            const QRectF area( xMap.s1(), yMap.s2(),
+                xMap.sDist(), yMap.s1() - yMap.s2() );
+
+            return renderImage( xMap, yMap, area, size );
+        }
+    };
+}
+
+// the per pixel algorithm of Qwt <= 6.2.0
+static QImage renderPerPixel( const QwtRasterData* data,
+    const QwtColorMap* colorMap, const QVector< QRgb >& colorTable,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QSize& size )
+{
+    const QwtInterval range = data->interval( Qt::ZAxis );
+
+    QImage image( size, QImage::Format_ARGB32 );
+
+    for ( int y = 0; y < size.height(); y++ )
+    {
+        const double ty = yMap.invTransform( y );
+
+        QRgb* line = reinterpret_cast< QRgb* >( image.scanLine( y ) );
+
+        for ( int x = 0; x < size.width(); x++ )
+        {
+            const double value = data->value( xMap.invTransform( x ), ty );
+
+            if ( colorTable.isEmpty() )
+            {
+                *line++ = colorMap->rgb( range, value );
+            }
+            else
+            {
+                const uint index = colorMap->colorIndex(
+                    colorTable.size(), range, value );
+
+                *line++ = colorTable[index];
+            }
+        }
+    }
+
+    return image;
+}
+
+static void report( const char* name, const QElapsedTimer& timer, int count )
+{
+    qDebug() << name << ":" << timer.elapsed() << "ms"
+             << double( timer.nsecsElapsed() ) / count << "ns/pixel";
+}
+
+static void testRendering( const char* name, Spectrogram& spectrogram,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap, const QSize& size )
+{
+    const int count = size.width() * size.height();
+
+    const QwtColorMap* colorMap = spectrogram.colorMap();
+
+    QVector< QRgb > colorTable;
+    if ( spectrogram.colorTableSize() > 0 )
+        colorTable = colorMap->colorTable( spectrogram.colorTableSize() );
+
+    qDebug() << "===" << name;
+
+    QElapsedTimer timer;
+
+    timer.start();
+    const QImage image1 = renderPerPixel( spectrogram.data(),
+        colorMap, colorTable, xMap, yMap, size );
+    report( "per pixel", timer, count );
+
+    spectrogram.setRenderThreadCount( 1 );
+
+    timer.start();
+    const QImage image2 = spectrogram.render( xMap, yMap, size );
+    report( "rows", timer, count );
+
+    spectrogram.setRenderThreadCount( 0 );
+
+    timer.start();
+    const QImage image3 = spectrogram.render( xMap, yMap, size );
+    report( "rows, threaded", timer, count );
+
+    // all paths have to end up with the same pixels
+
+    if ( image1 != image2 || image1 != image3 )
+        qDebug() << "Error: images differ";
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const int numColumns = 1024;
+    const int numRows = 1024;
+
+    QVector< double > values( numColumns * numRows );
+    for ( int row = 0; row < numRows; row++ )
+    {
+        for ( int col = 0; col < numColumns; col++ )
+        {
+            values[ row * numColumns + col ] =
+                std::sin( col * 0.02 ) * std::cos( row * 0.03 );
+        }
+    }
+
+    QwtMatrixRasterData* data = new QwtMatrixRasterData();
+    data->setInterval( Qt::XAxis, QwtInterval( 0.0, numColumns ) );
+    data->setInterval( Qt::YAxis, QwtInterval( 0.0, numRows ) );
+    data->setInterval( Qt::ZAxis, QwtInterval( -1.0, 1.0 ) );
+    data->setValueMatrix( values, numColumns );
+    data->setAttribute( QwtRasterData::WithoutGaps, true );
+
+    QwtLinearColorMap* colorMap = new QwtLinearColorMap( Qt::darkCyan, Qt::red );
+    colorMap->addColorStop( 0.1, Qt::cyan );
+    colorMap->addColorStop( 0.6, Qt::green );
+    colorMap->addColorStop( 0.95, Qt::yellow );
+
+    Spectrogram spectrogram;
+    spectrogram.setData( data );
+    spectrogram.setColorMap( colorMap );
+
+    const QSize size( 3840, 2160 ); // 4K
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, numColumns );
+    xMap.setPaintInterval( 0, size.width() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( 0.0, numRows );
+    yMap.setPaintInterval( size.height(), 0 );
+
+    testRendering( "NearestNeighbour", spectrogram, xMap, yMap, size );
+
+    spectrogram.setColorTableSize( 1024 );
+    testRendering( "NearestNeighbour, color table", spectrogram, xMap, yMap, size );
+
+    data->setResampleMode( QwtMatrixRasterData::BilinearInterpolation );
+    testRendering( "BilinearInterpolation, color table", spectrogram, xMap, yMap, size );
+
+    return 0;
+}
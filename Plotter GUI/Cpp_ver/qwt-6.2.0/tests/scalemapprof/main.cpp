@@ -0,0 +1,88 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtScaleMap>
+#include <QwtTransform>
+
+#include <QElapsedTimer>
+#include <QPointF>
+#include <QVector>
+#include <QDebug>
+
+#include <cmath>
+
+static void report( const char* name, const QElapsedTimer& timer, int count )
+{
+    qDebug() << name << ":" << timer.elapsed() << "ms"
+             << double( timer.nsecsElapsed() ) / count << "ns/value";
+}
+
+static void testMaps( const char* name,
+    const QwtScaleMap& xMap, const QwtScaleMap& yMap,
+    const QVector< QPointF >& points )
+{
+    const int count = points.size();
+
+    QVector< QPointF > result1( count );
+    QVector< QPointF > result2( count );
+
+    qDebug() << "===" << name;
+
+    QElapsedTimer timer;
+
+    timer.start();
+    for ( int i = 0; i < count; i++ )
+    {
+        result1[i] = QPointF( xMap.transform( points[i].x() ),
+            yMap.transform( points[i].y() ) );
+    }
+    report( "per point", timer, 2 * count );
+
+    timer.start();
+    QwtScaleMap::transform( xMap, yMap,
+        points.constData(), result2.data(), count );
+    report( "batch", timer, 2 * count );
+
+    // both paths have to end up with the same values
+
+    int numErrors = 0;
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( !qFuzzyCompare( result1[i].x() + 1.0, result2[i].x() + 1.0 )
+            || !qFuzzyCompare( result1[i].y() + 1.0, result2[i].y() + 1.0 ) )
+        {
+            numErrors++;
+        }
+    }
+
+    if ( numErrors > 0 )
+        qDebug() << "Errors:" << numErrors;
+}
+
+int main()
+{
+    const int count = 10e6;
+
+    QVector< QPointF > points( count );
+    for ( int i = 0; i < count; i++ )
+        points[i] = QPointF( i + 1, 1.0 + std::sin( i * 0.001 ) );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 1.0, count );
+    xMap.setPaintInterval( 0, 1920 );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( 0.0, 2.0 );
+    yMap.setPaintInterval( 1080, 0 );
+
+    testMaps( "Linear", xMap, yMap, points );
+
+    xMap.setTransformation( new QwtLogTransform() );
+    xMap.setScaleInterval( 1.0, count );
+
+    testMaps( "Log", xMap, yMap, points );
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtPlot>
+#include <QwtPlotCanvas>
+#include <QwtPlotGrid>
+#include <QwtPlotItem>
+#include <QwtPlotTextLabel>
+#include <QwtScaleMap>
+#include <QwtText>
+
+#include <QApplication>
+#include <QPainter>
+#include <QDebug>
+
+/*
+   An item, that records how often and with which clip
+   it has been painted
+ */
+class ProbeItem : public QwtPlotItem
+{
+  public:
+    ProbeItem()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        numDraws = 0;
+        hasClipping = false;
+        clipRect = QRectF();
+    }
+
+    virtual void draw( QPainter* painter,
+        const QwtScaleMap&, const QwtScaleMap&,
+        const QRectF& ) const QWT_OVERRIDE
+    {
+        numDraws++;
+
+        hasClipping = painter->hasClipping();
+        if ( hasClipping )
+            clipRect = painter->clipBoundingRect();
+    }
+
+    mutable int numDraws;
+    mutable bool hasClipping;
+    mutable QRectF clipRect;
+};
+
+static void shift( QwtPlot* plot, int pixels )
+{
+    const QwtScaleMap map = plot->canvasMap( QwtAxis::XBottom );
+    const double step = map.sDist() / map.pDist();
+
+    plot->setAxisScale( QwtAxis::XBottom,
+        map.s1() + pixels * step, map.s2() + pixels * step );
+}
+
+static void repaint( QwtPlot* plot, ProbeItem* probe )
+{
+    probe->reset();
+
+    plot->replot();
+    plot->canvas()->repaint();
+}
+
+static bool isFullRender( const QwtPlot* plot, const ProbeItem* probe )
+{
+    if ( probe->numDraws != 1 )
+        return false;
+
+    return !probe->hasClipping
+        || probe->clipRect.width() >= plot->canvas()->contentsRect().width();
+}
+
+int main( int argc, char* argv[] )
+{
+    // allows running the test without a display
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QApplication app( argc, argv );
+
+    int numErrors = 0;
+
+    QwtPlot plot;
+
+    QwtPlotCanvas* canvas = new QwtPlotCanvas();
+    canvas->setPaintAttribute( QwtPlotCanvas::BackingStore, true );
+    canvas->setPaintAttribute( QwtPlotCanvas::ScrollBackingStore, true );
+    plot.setCanvas( canvas );
+
+    // no scale widgets, that might change the layout while scrolling
+    plot.setAxisVisible( QwtAxis::XBottom, false );
+    plot.setAxisVisible( QwtAxis::YLeft, false );
+
+    plot.setAxisScale( QwtAxis::XBottom, 0.0, 100.0 );
+    plot.setAxisScale( QwtAxis::YLeft, -1.0, 1.0 );
+
+    QwtPlotGrid* grid = new QwtPlotGrid();
+    grid->attach( &plot );
+
+    ProbeItem* probe = new ProbeItem();
+    probe->attach( &plot );
+
+    plot.resize( 400, 300 );
+    plot.show();
+
+    QCoreApplication::processEvents();
+    repaint( &plot, probe );
+
+    if ( !isFullRender( &plot, probe ) )
+    {
+        qDebug() << "  the initial backing store has not been rendered";
+        numErrors++;
+    }
+
+    {
+        qDebug() << "=== unchanged";
+
+        repaint( &plot, probe );
+
+        if ( probe->numDraws != 0 )
+        {
+            qDebug() << "  rendered" << probe->numDraws << "times";
+            numErrors++;
+        }
+    }
+
+    {
+        qDebug() << "=== shifted";
+
+        const int pixels = 10;
+
+        for ( int i = 0; i < 20; i++ )
+        {
+            shift( &plot, pixels );
+            repaint( &plot, probe );
+
+            if ( probe->numDraws != 1 || !probe->hasClipping
+                || qRound( probe->clipRect.width() ) != pixels )
+            {
+                qDebug() << "  shift" << i << ": no strip of" << pixels << "pixels:"
+                         << probe->numDraws << probe->hasClipping << probe->clipRect;
+                numErrors++;
+                break;
+            }
+        }
+    }
+
+    {
+        qDebug() << "=== shifted by a fraction of a pixel";
+
+        const QwtScaleMap map = plot.canvasMap( QwtAxis::XBottom );
+        const double step = 0.5 * map.sDist() / map.pDist();
+
+        plot.setAxisScale( QwtAxis::XBottom, map.s1() + step, map.s2() + step );
+        repaint( &plot, probe );
+
+        if ( !isFullRender( &plot, probe ) )
+        {
+            qDebug() << "  the backing store has not been rendered again";
+            numErrors++;
+        }
+    }
+
+    {
+        qDebug() << "=== new ticks for the same interval";
+
+        plot.setAxisMaxMajor( QwtAxis::XBottom, 3 );
+        repaint( &plot, probe );
+
+        if ( !isFullRender( &plot, probe ) )
+        {
+            qDebug() << "  the backing store has not been rendered again";
+            numErrors++;
+        }
+    }
+
+    {
+        qDebug() << "=== label anchored to the canvas";
+
+        QwtPlotTextLabel* label = new QwtPlotTextLabel();
+        label->setText( QwtText( "Label" ) );
+        label->attach( &plot );
+
+        repaint( &plot, probe );
+
+        shift( &plot, 10 );
+        repaint( &plot, probe );
+
+        if ( !isFullRender( &plot, probe ) )
+        {
+            qDebug() << "  the backing store has been scrolled";
+            numErrors++;
+        }
+    }
+
+    return ( numErrors == 0 ) ? 0 : 1;
+}
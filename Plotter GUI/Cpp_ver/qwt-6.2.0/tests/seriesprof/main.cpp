@@ -0,0 +1,132 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtPointArrayData>
+#include <QwtCPointerData>
+#include <QwtPointSeriesData>
+#include <QwtPointMapper>
+#include <QwtScaleMap>
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPen>
+#include <QDebug>
+
+#include <cmath>
+
+/*
+   Series without sampleBlock(): each sample is fetched
+   by a virtual call of sample(), what is the old behaviour
+ */
+class PerSampleData : public QwtSeriesData< QPointF >
+{
+  public:
+    PerSampleData( const QVector< double >& x, const QVector< double >& y )
+        : m_x( x )
+        , m_y( y )
+    {
+    }
+
+    virtual size_t size() const QWT_OVERRIDE
+    {
+        return m_x.size();
+    }
+
+    virtual QPointF sample( size_t i ) const QWT_OVERRIDE
+    {
+        return QPointF( m_x[ int( i ) ], m_y[ int( i ) ] );
+    }
+
+    virtual QRectF boundingRect() const QWT_OVERRIDE
+    {
+        return qwtBoundingRect( *this );
+    }
+
+  private:
+    QVector< double > m_x;
+    QVector< double > m_y;
+};
+
+static void report( const char* name, const char* what,
+    const QElapsedTimer& timer, int numPoints )
+{
+    const double ns = double( timer.nsecsElapsed() ) / numPoints;
+    qDebug() << name << what << ":" << timer.elapsed() << "ms" << ns << "ns/point";
+}
+
+static void testSeries( const char* name, const QwtSeriesData< QPointF >* series )
+{
+    const int numPoints = int( series->size() );
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, numPoints );
+    xMap.setPaintInterval( 0, 1920 );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( -1.0, 1.0 );
+    yMap.setPaintInterval( 1080, 0 );
+
+    QElapsedTimer timer;
+
+    timer.start();
+    const QRectF rect = qwtBoundingRect( *series );
+    report( name, "boundingRect", timer, numPoints );
+
+    QwtPointMapper mapper;
+
+    mapper.setFlags( QwtPointMapper::RoundPoints
+        | QwtPointMapper::WeedOutIntermediatePoints );
+
+    timer.start();
+    const QPolygonF polyline = mapper.toPolygonF(
+        xMap, yMap, series, 0, numPoints - 1 );
+    report( name, "toPolygonF", timer, numPoints );
+
+    mapper.setFlags( QwtPointMapper::WeedOutPoints );
+
+    timer.start();
+    const QPolygon points = mapper.toPoints(
+        xMap, yMap, series, 0, numPoints - 1 );
+    report( name, "toPoints", timer, numPoints );
+
+    mapper.setBoundingRect( QRectF( 0, 0, 1920, 1080 ) );
+
+    timer.start();
+    const QImage image = mapper.toImage( xMap, yMap,
+        series, 0, numPoints - 1, QPen( Qt::black ), false, 1 );
+    report( name, "toImage", timer, numPoints );
+
+    Q_UNUSED( rect )
+}
+
+int main()
+{
+    const int numPoints = 10e6;
+
+    QVector< double > x( numPoints );
+    QVector< double > y( numPoints );
+    QVector< QPointF > points( numPoints );
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        x[i] = i;
+        y[i] = std::sin( i * 0.001 ) + 0.1 * std::sin( i * 0.37 );
+        points[i] = QPointF( x[i], y[i] );
+    }
+
+    PerSampleData perSampleData( x, y );
+    testSeries( "sample()", &perSampleData );
+
+    QwtPointArrayData< double > arrayData( x, y );
+    testSeries( "QwtPointArrayData", &arrayData );
+
+    QwtCPointerData< double > cpointerData( x.constData(), y.constData(), numPoints );
+    testSeries( "QwtCPointerData", &cpointerData );
+
+    QwtPointSeriesData pointData( points );
+    testSeries( "QwtPointSeriesData", &pointData );
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtSymbol>
+#include <QwtPlotCurve>
+#include <QwtScaleMap>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QImage>
+#include <QPixmap>
+#include <QVector>
+#include <QDebug>
+
+#include <cstdlib>
+
+static void report( const char* name, const QElapsedTimer& timer, int numPoints )
+{
+    qDebug() << name << ":" << timer.elapsed() << "ms"
+             << double( timer.nsecsElapsed() ) / numPoints << "ns/point";
+}
+
+static QImage drawSymbols( const char* name, const QwtSymbol& symbol,
+    const QVector< QPointF >& points, const QSize& size )
+{
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter painter( &image );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+
+    symbol.drawSymbols( &painter, points.constData(), points.size() );
+
+    painter.end();
+
+    report( name, timer, points.size() );
+
+    return image;
+}
+
+static void drawSymbolsToPixmap( const char* name, const QwtSymbol& symbol,
+    const QVector< QPointF >& points, const QSize& size )
+{
+    // the canvas backing store is a pixmap
+
+    QPixmap pixmap( size );
+    pixmap.fill( Qt::white );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter painter( &pixmap );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+
+    symbol.drawSymbols( &painter, points.constData(), points.size() );
+
+    painter.end();
+
+    report( name, timer, points.size() );
+}
+
+static int countDifferences( const QImage& image1, const QImage& image2 )
+{
+    int count = 0;
+
+    for ( int y = 0; y < image1.height(); y++ )
+    {
+        const QRgb* line1 = reinterpret_cast< const QRgb* >( image1.constScanLine( y ) );
+        const QRgb* line2 = reinterpret_cast< const QRgb* >( image2.constScanLine( y ) );
+
+        for ( int x = 0; x < image1.width(); x++ )
+        {
+            if ( line1[x] != line2[x] )
+                count++;
+        }
+    }
+
+    return count;
+}
+
+static void testSymbol( const char* name, QwtSymbol& symbol,
+    const QVector< QPointF >& points, const QSize& size )
+{
+    qDebug() << "===" << name << points.size() << "points";
+
+    symbol.setCachePolicy( QwtSymbol::NoCache );
+    drawSymbols( "NoCache", symbol, points, size );
+
+    symbol.setCachePolicy( QwtSymbol::Cache );
+    const QImage image1 = drawSymbols( "Cache", symbol, points, size );
+    drawSymbolsToPixmap( "Cache, pixmap", symbol, points, size );
+
+    symbol.setCachePolicy( QwtSymbol::SpriteCache );
+    const QImage image2 = drawSymbols( "SpriteCache", symbol, points, size );
+    drawSymbolsToPixmap( "SpriteCache, pixmap", symbol, points, size );
+
+    // the sprites are composited with the rounding of the raster engine
+
+    const int count = countDifferences( image1, image2 );
+    if ( count > 0 )
+        qDebug() << "Cache and SpriteCache differ in" << count << "pixels";
+}
+
+static void testDots( const QVector< QPointF >& points, const QSize& size )
+{
+    qDebug() << "=== QwtPlotCurve::Dots" << points.size() << "points";
+
+    QwtScaleMap xMap;
+    xMap.setScaleInterval( 0.0, size.width() );
+    xMap.setPaintInterval( 0.0, size.width() );
+
+    QwtScaleMap yMap;
+    yMap.setScaleInterval( 0.0, size.height() );
+    yMap.setPaintInterval( 0.0, size.height() );
+
+    QwtPlotCurve curve;
+    curve.setStyle( QwtPlotCurve::Dots );
+    curve.setPen( Qt::darkBlue );
+    curve.setSamples( points );
+
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::white );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter painter( &image );
+    curve.draw( &painter, xMap, yMap, QRectF( QPointF(), size ) );
+    painter.end();
+
+    report( "Dots", timer, points.size() );
+}
+
+int main( int argc, char* argv[] )
+{
+    QGuiApplication app( argc, argv );
+
+    const QSize size( 1920, 1080 );
+    const int numPoints = 1000000;
+
+    QVector< QPointF > points( numPoints );
+
+    std::srand( 42 );
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        const double x = double( std::rand() ) / RAND_MAX * size.width();
+        const double y = double( std::rand() ) / RAND_MAX * size.height();
+
+        points[i] = QPointF( x, y );
+    }
+
+    QwtSymbol ellipse( QwtSymbol::Ellipse,
+        QBrush( Qt::yellow ), QPen( Qt::red, 1 ), QSize( 7, 7 ) );
+    testSymbol( "Ellipse", ellipse, points, size );
+
+    QwtSymbol triangle( QwtSymbol::Triangle,
+        QBrush( QColor( 0, 0, 255, 128 ) ), QPen( Qt::darkBlue, 1 ), QSize( 9, 9 ) );
+    testSymbol( "Triangle, translucent", triangle, points, size );
+
+    testDots( points, size );
+
+    return 0;
+}
@@ -13,4 +13,24 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     splinetest \
-    splineprof
+    splineprof \
+    seriesprof \
+    scalemapprof \
+    rasterprof \
+    symbolprof \
+    clipprof \
+    columntest \
+    weedingtest \
+    linerastertest \
+    scrolltest
+
+contains(QWT_CONFIG, QwtOpenGL) {
+
+    greaterThan(QT_MAJOR_VERSION, 4) {
+
+        greaterThan(QT_MINOR_VERSION, 3) | greaterThan(QT_MAJOR_VERSION, 5) {
+
+            SUBDIRS += glcurvetest
+        }
+    }
+}
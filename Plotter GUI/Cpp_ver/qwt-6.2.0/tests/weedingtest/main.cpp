@@ -0,0 +1,198 @@
+/*****************************************************************************
+* Qwt Examples - Copyright (C) 2002 Uwe Rathmann
+* This file may be used under the terms of the 3-clause BSD License
+*****************************************************************************/
+
+#include <QwtWeedingCurveFitter>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QPolygonF>
+#include <QDebug>
+
+#include <cmath>
+
+static const double tolerance = 2.0;
+
+/*
+   A random walk with increasing x coordinates
+ */
+static QPolygonF createSeries( int numPoints )
+{
+    QPolygonF points( numPoints );
+
+    quint32 random = 1;
+    double y = 0.0;
+
+    for ( int i = 0; i < numPoints; i++ )
+    {
+        random = random * 1664525u + 1013904223u;
+        y += double( random >> 8 ) / double( 1 << 24 ) - 0.5;
+
+        points[i] = QPointF( 0.1 * i, y );
+    }
+
+    return points;
+}
+
+static double distanceToSegment( const QPointF& pos,
+    const QPointF& p1, const QPointF& p2 )
+{
+    const double dx = p2.x() - p1.x();
+    const double dy = p2.y() - p1.y();
+
+    const double lengthSqr = dx * dx + dy * dy;
+
+    double t = 0.0;
+    if ( lengthSqr > 0.0 )
+    {
+        t = ( ( pos.x() - p1.x() ) * dx + ( pos.y() - p1.y() ) * dy ) / lengthSqr;
+        t = qBound( 0.0, t, 1.0 );
+    }
+
+    return std::hypot( pos.x() - ( p1.x() + t * dx ), pos.y() - ( p1.y() + t * dy ) );
+}
+
+/*
+   The fitted points are a subset of the points in the same order.
+   Each point has to be within the tolerance of the fitted segment,
+   that is spanning it.
+ */
+static int checkTolerance( const QPolygonF& points, const QPolygonF& fitted )
+{
+    if ( fitted.isEmpty() || fitted.first() != points.first()
+        || fitted.last() != points.last() )
+    {
+        qDebug() << "  the end points are not kept";
+        return 1;
+    }
+
+    int numErrors = 0;
+
+    int j = 0;
+    for ( int i = 0; i < points.size(); i++ )
+    {
+        if ( points[i] == fitted[j] )
+        {
+            if ( j < fitted.size() - 1 )
+                j++;
+
+            continue;
+        }
+
+        if ( j == 0 )
+        {
+            qDebug() << "  fitted points are no subset";
+            return numErrors + 1;
+        }
+
+        const double distance = distanceToSegment( points[i], fitted[j - 1], fitted[j] );
+        if ( distance > tolerance * ( 1.0 + 1e-9 ) )
+        {
+            if ( numErrors < 10 )
+                qDebug() << "  point" << i << "out of tolerance:" << distance;
+
+            numErrors++;
+        }
+    }
+
+    if ( j != fitted.size() - 1 )
+    {
+        qDebug() << "  fitted points are no subset";
+        numErrors++;
+    }
+
+    return numErrors;
+}
+
+static QPolygonF fit( const char* name,
+    const QwtWeedingCurveFitter& fitter, const QPolygonF& points )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QPolygonF fitted = fitter.fitCurve( points );
+
+    qDebug() << "  " << name << ":" << timer.elapsed() << "ms"
+             << points.size() << "->" << fitted.size() << "points";
+
+    return fitted;
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    int numErrors = 0;
+
+    const QPolygonF points = createSeries( 1000000 );
+
+    {
+        qDebug() << "=== complete polygon";
+
+        QwtWeedingCurveFitter fitter( tolerance );
+        numErrors += checkTolerance( points, fit( "iterative", fitter, points ) );
+    }
+
+    {
+        qDebug() << "=== chunks";
+
+        QwtWeedingCurveFitter fitter( tolerance );
+        fitter.setChunkSize( 10000 );
+
+        fitter.setThreadCount( 1 );
+        const QPolygonF sequential = fit( "sequential", fitter, points );
+
+        fitter.setThreadCount( 0 );
+        const QPolygonF parallel = fit( "parallel", fitter, points );
+
+        if ( parallel != sequential )
+        {
+            qDebug() << "  parallel and sequential results differ";
+            numErrors++;
+        }
+
+        numErrors += checkTolerance( points, parallel );
+    }
+
+    {
+        qDebug() << "=== streaming";
+
+        QwtWeedingCurveFitter fitter( tolerance );
+        fitter.setChunkSize( 10000 );
+        fitter.setStreaming( true );
+
+        const int step = 997;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QPolygonF fitted;
+
+        for ( int numPoints = step; numPoints < 200000; numPoints += step )
+        {
+            const QPolygonF part = points.mid( 0, numPoints );
+            fitted = fitter.fitCurve( part );
+
+            const int errors = checkTolerance( part, fitted );
+            if ( errors > 0 )
+            {
+                qDebug() << "  after appending up to" << numPoints << "points";
+                numErrors += errors;
+                break;
+            }
+        }
+
+        qDebug() << "  " << "appending" << ":" << timer.elapsed() << "ms"
+                 << fitted.size() << "points";
+
+        // a modified polygon has to be simplified from scratch
+
+        QPolygonF modified = points.mid( 0, 50000 );
+        modified[100].ry() += 100.0;
+
+        numErrors += checkTolerance( modified, fitter.fitCurve( modified ) );
+    }
+
+    return ( numErrors == 0 ) ? 0 : 1;
+}